@@ -0,0 +1,199 @@
+// Microbenchmarks for the per-tick hot path and the ready queues, built on
+// Google Benchmark:
+//
+//   g++ -std=c++17 -O2 -Isrc bench/microbench.cpp src/core/*.cpp
+//       -lbenchmark -lpthread -o csopesy-microbench
+//   ./csopesy-microbench --benchmark_filter=RunOneTick
+//
+// Global operator new is replaced to count allocations (tools/alloc_count.h).
+//
+// BM_Process_Log/1 writes traces under bench-logs/ in the working directory.
+#include "core/instruction.h"
+#include "core/log_writer.h"
+#include "core/object_pool.h"
+#include "core/process.h"
+#include "core/process_manager.h"
+#include "core/scheduler.h"
+#include "core/time_utils.h"
+#include "tools/alloc_count.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kOpsPerProgram = 4096;
+
+enum class Shape { PRINT, DECL, ADD, SUB, SLEEP, LOOP };
+
+// kOpsPerProgram copies of one instruction, or one FOR whose END jumps
+// back kOpsPerProgram times
+std::shared_ptr<const Program> make_program(Shape shape)
+{
+    std::vector<std::unique_ptr<Instruction>> code;
+    code.push_back(std::make_unique<DeclInst>("x", 1));
+    if (shape == Shape::LOOP) {
+        code.push_back(std::make_unique<ForInst>(
+            kOpsPerProgram, std::vector<std::unique_ptr<Instruction>>{}));
+    } else {
+        for (int i = 0; i < kOpsPerProgram; ++i) {
+            switch (shape) {
+            case Shape::PRINT: code.push_back(std::make_unique<PrintInst>()); break;
+            case Shape::DECL:  code.push_back(std::make_unique<DeclInst>("y", i & 0xff));        break;
+            case Shape::ADD:   code.push_back(std::make_unique<MathInst>("x", "x", "1", true));  break;
+            case Shape::SUB:   code.push_back(std::make_unique<MathInst>("x", "x", "1", false)); break;
+            case Shape::SLEEP: code.push_back(std::make_unique<SleepInst>(0));                   break;
+            case Shape::LOOP:  break;
+            }
+        }
+    }
+    return std::make_shared<const Program>(compile(code));
+}
+
+// One tick per iteration; a finished process is replaced off the clock.
+void BM_RunOneTick(benchmark::State& state, Shape shape)
+{
+    const auto prog = make_program(shape);
+    auto p = std::make_unique<Process>("bench", 1, prog);
+    for (auto _ : state) {
+        if (p->is_finished()) {
+            state.PauseTiming();
+            p = std::make_unique<Process>("bench", 1, prog);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(p->run_one_tick());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_RunOneTick, PRINT, Shape::PRINT);
+BENCHMARK_CAPTURE(BM_RunOneTick, DECL,  Shape::DECL);
+BENCHMARK_CAPTURE(BM_RunOneTick, ADD,   Shape::ADD);
+BENCHMARK_CAPTURE(BM_RunOneTick, SUB,   Shape::SUB);
+BENCHMARK_CAPTURE(BM_RunOneTick, SLEEP, Shape::SLEEP);
+BENCHMARK_CAPTURE(BM_RunOneTick, FOR_END, Shape::LOOP);
+
+// Arg 0: in-memory history only. Arg 1: also hand the record to a LogWriter.
+void BM_Process_Log(benchmark::State& state)
+{
+    std::unique_ptr<LogWriter> writer;
+    if (state.range(0)) writer = std::make_unique<LogWriter>(1, 64, "bench-logs");
+    Process p("bench", 1, make_program(Shape::PRINT), writer.get());
+    p.set_core_id(0);
+    TraceRecord rec;
+    rec.op = Op::PRINT;
+    for (auto _ : state) {
+        ++rec.pc;
+        p.log(rec);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Process_Log)->Arg(0)->Arg(1);
+
+void BM_NowTime(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(util::now_time());
+}
+BENCHMARK(BM_NowTime);
+
+void BM_NowTimeCstr(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(util::now_time_cstr());
+}
+BENCHMARK(BM_NowTimeCstr);
+
+// One add_process + next_process pair per iteration, every thread sharing
+// one scheduler; the queue holds a few processes per thread so pops rarely
+// come back empty.
+template <typename Sched>
+std::unique_ptr<SchedulerBase> make_scheduler();
+template <> std::unique_ptr<SchedulerBase> make_scheduler<FCFSScheduler>() { return std::make_unique<FCFSScheduler>(); }
+template <> std::unique_ptr<SchedulerBase> make_scheduler<RRScheduler>()   { return std::make_unique<RRScheduler>(5); }
+template <> std::unique_ptr<SchedulerBase> make_scheduler<ShortestJobScheduler>() { return std::make_unique<ShortestJobScheduler>(true); }
+template <> std::unique_ptr<SchedulerBase> make_scheduler<MLFQScheduler>() { return std::make_unique<MLFQScheduler>(std::vector<uint64_t>{5, 10, 20}, 0); }
+
+template <typename Sched>
+void BM_Scheduler_PushPop(benchmark::State& state)
+{
+    static std::unique_ptr<SchedulerBase> sched;
+    static std::shared_ptr<const Program> prog = make_program(Shape::ADD);
+    if (state.thread_index() == 0) {
+        sched = make_scheduler<Sched>();
+        for (int i = 0; i < 4 * state.threads(); ++i)
+            sched->add_process(std::make_shared<Process>("seed" + std::to_string(i), i, prog));
+    }
+    auto mine = std::make_shared<Process>("t" + std::to_string(state.thread_index()),
+                                          state.thread_index(), prog);
+    for (auto _ : state) {
+        sched->add_process(std::move(mine));
+        mine = sched->next_process();
+        if (!mine) mine = std::make_shared<Process>("t", 0, prog);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        state.counters["queued"] = static_cast<double>(sched->queued());
+    }
+}
+BENCHMARK_TEMPLATE(BM_Scheduler_PushPop, FCFSScheduler)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Scheduler_PushPop, RRScheduler)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Scheduler_PushPop, ShortestJobScheduler)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Scheduler_PushPop, MLFQScheduler)->ThreadRange(1, 8)->UseRealTime();
+
+// get_process by name against a registry of state.range(0) live processes.
+// The registry is built once per size and reused across repetitions.
+void BM_GetProcess(benchmark::State& state)
+{
+    static std::unique_ptr<ProcessManager> pm;
+    static std::size_t built = 0;
+    static std::vector<std::string> names;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    if (built != n) {
+        pm.reset();
+        pm = std::make_unique<ProcessManager>(1);
+        const auto prog = make_program(Shape::PRINT);
+        names.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            names.push_back("p" + std::to_string(i));
+            pm->submit(names.back(), prog);
+        }
+        std::shuffle(names.begin(), names.end(), std::mt19937(7));
+        built = n;
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pm->get_process(names[i]));
+        if (++i == names.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetProcess)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+
+// Process churn with 1024 live: each iteration creates one process and
+// retires the oldest. /0 uses make_shared, /1 the PoolArena slots that
+// ProcessManager admits into; allocs_per_iter counts heap allocations.
+void BM_MakeProcess(benchmark::State& state)
+{
+    const bool pooled = state.range(0) != 0;
+    const auto prog = make_program(Shape::PRINT);
+    std::vector<std::shared_ptr<Process>> live(1024);
+    std::size_t i = 0;
+    for (auto& p : live)        // warm the pool
+        p = pooled ? make_pooled<Process>("p", 0, prog) : std::make_shared<Process>("p", 0, prog);
+    const uint64_t allocs0 = thread_heap_allocs();
+    for (auto _ : state) {
+        live[i] = pooled ? make_pooled<Process>("p", 0, prog) : std::make_shared<Process>("p", 0, prog);
+        if (++i == live.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_iter"] =
+        static_cast<double>(thread_heap_allocs() - allocs0) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_MakeProcess)->Arg(0)->Arg(1);
+
+}  // namespace
+
+BENCHMARK_MAIN();
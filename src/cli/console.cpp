@@ -1,6 +1,7 @@
 #include "console.h"
 #include "core/process_manager.h"
 #include "core/config_manager.h"
+#include "core/sched_bench.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
@@ -122,6 +123,7 @@ void Console::show_help() const
         std::cout << "    scheduler-test     - Start automatically generating dummy processes.\n";
         std::cout << "    scheduler-stop      - Stop generating dummy processes.\n";
         std::cout << "    report-util         - Generate and save CPU utilization report to csopesy-log.txt.\n";
+        std::cout << "    benchmark [n] [seed] - Compare FCFS, RR, SJF and SRTF turnaround on n seeded jobs.\n";
         std::cout << "    exit                - Terminate the console.\n";
         std::cout << "    help                - Show this help message.\n";
         std::cout << "    clear               - Clear the console screen.\n";
@@ -166,10 +168,14 @@ void Console::handle_report_util()
 
     /* one snapshot → write to file, then to console */
     process_manager->print_system_status(fout);
+    process_manager->print_utilization_trend(fout);
+    process_manager->print_latency_stats(fout);
     process_manager->print_process_lists(fout, true);
     process_manager->print_recent_logs(fout, 5);
 
     process_manager->print_system_status(std::cout);
+    process_manager->print_utilization_trend(std::cout);
+    process_manager->print_latency_stats(std::cout);
     process_manager->print_process_lists(std::cout, false);
     process_manager->print_recent_logs(std::cout, 5);
 
@@ -218,6 +224,8 @@ void Console::handle_screen_command(const std::string& command) {
         if (process && !process->is_finished()) {
             in_process_screen = true;
             current_process_name = process_name;
+        } else if (process || process_manager->get_finished_process(process_name)) {
+            std::cout << "Process " << process_name << " has finished execution.\n";
         } else {
             std::cout << "Process " << process_name << " not found.\n";
         }
@@ -232,12 +240,13 @@ void Console::enter_process_screen(const std::string& process_name) {
     clear_screen();
 
     auto process = process_manager->get_process(process_name);
-    if (!process) {
+    if (!process && !process_manager->get_finished_process(process_name)) {
         std::cout << "Process " << process_name << " not found.\n";
         in_process_screen = false;
         return;
     }
-    if (process->is_finished()) {
+    // finished processes leave the live index for the archive
+    if (!process || process->is_finished()) {
         std::cout << "Process " << process_name << " has finished execution.\n";
         in_process_screen = false;
         print_header();
@@ -250,7 +259,7 @@ void Console::enter_process_screen(const std::string& process_name) {
         std::cout << "Logs:\n";
         {
             auto recent = process->recent_logs(5);
-            for (auto& ln : recent) std::cout << ln << '\n';
+            for (const auto& rec : recent) std::cout << render_trace(rec) << '\n';
         }
         std::cout << "\nCurrent instruction line: "
                   << process->get_pc() << '/' << process->get_code_size() << '\n';
@@ -310,13 +319,44 @@ void Console::handle_scheduler_stop()
     std::cout << "Scheduler stopped generating dummy processes.\n";
 }
 
+void Console::handle_benchmark(const std::string& command)
+{
+    if (process_manager->is_batching()) {
+        std::cout << "Run scheduler-stop first; the benchmark shares the CPU cycle counter.\n";
+        return;
+    }
+    if (!process_manager->is_idle()) {
+        std::cout << "Wait for running processes to finish; the benchmark shares the CPU cycle counter.\n";
+        return;
+    }
+    SchedBenchConfig cfg;
+    cfg.cores   = static_cast<uint32_t>(config_manager.get_long("num-cpu"));
+    cfg.quantum = config_manager.get_long("quantum-cycles");
+    cfg.min_ins = static_cast<int>(config_manager.get_long("min-ins"));
+    cfg.max_ins = static_cast<int>(config_manager.get_long("max-ins"));
+    cfg.delay   = static_cast<int>(config_manager.get_long("delays-per-exec"));
+
+    std::istringstream iss(command);
+    std::string cmd;
+    unsigned long long jobs = cfg.jobs, seed = cfg.seed;
+    iss >> cmd;
+    if (iss >> jobs) iss >> seed;
+    if (jobs == 0) { std::cout << "Usage: benchmark [jobs] [seed]\n"; return; }
+    cfg.jobs = jobs;
+    cfg.seed = static_cast<uint32_t>(seed);
+
+    std::cout << "Running benchmark...\n";
+    print_sched_bench(std::cout, cfg, run_sched_bench(cfg, {"fcfs", "rr", "sjf", "srtf"}));
+}
+
 void Console::handle_process_command(const std::string &input)
 {
     std::string cmd = input;
     std::transform(cmd.begin(), cmd.end(), cmd.begin(), ::tolower);
 
-    auto process = process_manager->get_process(current_process_name);
-    if (!process)
+    // a process that finished while attached has moved to the archive
+    if (!process_manager->get_process(current_process_name)
+        && !process_manager->get_finished_process(current_process_name))
     {
         std::cout << "Process '" << current_process_name << "' no longer exists. Returning to main menu.\n";
         exit_process_screen();
@@ -329,16 +369,7 @@ void Console::handle_process_command(const std::string &input)
     }
     if (cmd == "process-smi")
     {
-        std::cout << "===== Process Name: " << process->get_name() << " =====\n";
-        std::cout << "ID: " << process->get_id() << '\n';
-        std::cout << "Logs:\n";
-        {
-            auto recent = process->recent_logs(5);
-            for (auto& ln : recent) std::cout << ln << '\n';
-        }
-        std::cout << "\nCurrent instruction line: "
-                  << process->get_pc() << '/' << process->get_code_size() << '\n';
-        if (process->is_finished()) std::cout << "\nFINISHED!\n";
+        process_manager->print_process_smi(current_process_name, std::cout);
     }
     else
     {
@@ -398,6 +429,7 @@ void Console::run() {
         else if (command_base == "scheduler-test" || command_base == "scheduler-test") handle_scheduler_start();
         else if (command_base == "scheduler-stop") handle_scheduler_stop();
         else if (command_base == "report-util")  handle_report_util();
+        else if (command_base == "benchmark")    handle_benchmark(input);
         else std::cout << "Invalid command. Type 'help' for available commands.\n";
     }
     std::cout << "Terminating console. Goodbye!\n";
@@ -44,6 +44,7 @@ private:
     void handle_report_util();
     void handle_scheduler_start();
     void handle_scheduler_stop();
+    void handle_benchmark(const std::string& command);
     void handle_process_command(const std::string& input);
     void enter_process_screen(const std::string& process_name);
     void exit_process_screen();
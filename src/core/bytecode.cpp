@@ -0,0 +1,87 @@
+#include "bytecode.h"
+#include "instruction.h"
+#include <array>
+#include <cctype>
+#include <stdexcept>
+
+const char* op_tag(Op op)
+{
+    switch (op) {
+    case Op::PRINT: return "PRINT";
+    case Op::DECL:  return "DECL";
+    case Op::ADD:   return "ADD";
+    case Op::SUB:   return "SUB";
+    case Op::SLEEP: return "SLEEP";
+    case Op::FOR:   return "FOR";
+    case Op::END:   return "END";
+    }
+    return "?";
+}
+
+uint16_t ProgramBuilder::slot(const std::string& var)
+{
+    auto it = slots.find(var);
+    if (it != slots.end()) return it->second;
+    if (prog.symbols.size() >= kMaxVars) return kSinkSlot;
+    auto s = static_cast<uint16_t>(prog.symbols.size());
+    prog.symbols.push_back(var);
+    slots.emplace(var, s);
+    return s;
+}
+
+void ProgramBuilder::enter_loop()
+{
+    if (loop_depth == kMaxLoopDepth)
+        throw std::runtime_error("FOR nested deeper than " + std::to_string(kMaxLoopDepth));
+    ++loop_depth;
+}
+
+bool ProgramBuilder::operand(const std::string& s, uint16_t& out)
+{
+    if (!s.empty() && isdigit(static_cast<unsigned char>(s[0]))) {
+        unsigned long v = std::stoul(s);
+        out = static_cast<uint16_t>(v > 65535 ? 65535 : v);
+        return true;
+    }
+    auto it = slots.find(s);
+    if (it == slots.end()) { out = 0; return true; }
+    out = it->second;
+    return false;
+}
+
+Program compile(const std::vector<std::unique_ptr<Instruction>>& src)
+{
+    ProgramBuilder b;
+    for (const auto& inst : src)
+        inst->compile(b);
+    Program prog = b.finish();
+    prog.ticks = count_ticks(prog);
+    return prog;
+}
+
+// Mirrors the control flow of Process::run_one_tick.
+uint64_t count_ticks(const Program& prog)
+{
+    const auto& code = prog.code;
+    std::array<uint32_t, kMaxLoopDepth> remaining{};
+    std::size_t depth = 0, pc = 0;
+    uint64_t ticks = 0;
+    while (pc < code.size()) {
+        const Bytecode& bc = code[pc++];
+        ++ticks;
+        switch (bc.op) {
+        case Op::FOR:
+            if (bc.a == 0 || depth == kMaxLoopDepth) pc = bc.imm;
+            else remaining[depth++] = bc.a;
+            break;
+        case Op::END:
+            if (depth == 0) break;
+            if (--remaining[depth - 1] > 0) pc = bc.imm;
+            else --depth;
+            break;
+        default:
+            break;
+        }
+    }
+    return ticks;
+}
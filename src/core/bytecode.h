@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Instruction;
+
+// Per-process symbol table capacity. Slot kSinkSlot absorbs writes to
+// variables declared past the limit; reads of those names compile to 0.
+constexpr std::size_t kMaxVars  = 32;
+constexpr uint16_t    kSinkSlot = kMaxVars;
+
+// FOR loops may nest this deep; loop state lives in the process, not here.
+constexpr std::size_t kMaxLoopDepth = 3;
+
+// Flat opcode set the interpreter in Process::run_one_tick dispatches on.
+enum class Op : uint8_t { PRINT, DECL, ADD, SUB, SLEEP, FOR, END };
+
+const char* op_tag(Op op);
+
+// One compiled instruction. Operands are pre-resolved: variables are slot
+// indices into the process's variable array, literals are immediates.
+struct Bytecode {
+    enum : uint8_t { A_IMM = 1, B_IMM = 2 };
+    Op       op;
+    uint8_t  flags = 0;
+    uint16_t dst   = 0;           // DECL/ADD/SUB target slot
+    uint16_t a     = 0;           // slot, or immediate when A_IMM
+    uint16_t b     = 0;           // slot, or immediate when B_IMM
+    uint32_t imm   = 0;           // SLEEP ticks, FOR: pc past its END,
+                                  // END: first body pc
+};
+// FOR keeps its repeat count in `a`.
+
+struct Program {
+    std::vector<Bytecode>    code;
+    std::vector<std::string> symbols;   // slot -> variable name, at most kMaxVars
+    uint64_t                 ticks = 0; // instructions executed to completion
+};
+
+// Exact count of instructions a run executes, loop repeats included; SLEEP
+// time is not CPU work and is left out. Control flow never depends on
+// variable values, so this is a dry run of pc and the loop stack.
+uint64_t count_ticks(const Program& prog);
+
+// Lowers an Instruction tree into a Program; each Instruction emits itself.
+class ProgramBuilder {
+public:
+    void     emit(const Bytecode& bc) { prog.code.push_back(bc); }
+    uint32_t here() const { return static_cast<uint32_t>(prog.code.size()); }
+    Bytecode& at(uint32_t pc) { return prog.code[pc]; }
+    // FOR nesting guard; throws past kMaxLoopDepth
+    void     enter_loop();
+    void     leave_loop() { --loop_depth; }
+    // slot for a written variable; kSinkSlot once the table is full
+    uint16_t slot(const std::string& var);
+    // resolves "v3" to a slot, "42" to an immediate; returns true if immediate.
+    // Unknown variables read as immediate 0 without taking a slot.
+    bool     operand(const std::string& s, uint16_t& out);
+    Program  finish() { return std::move(prog); }
+private:
+    Program prog;
+    std::unordered_map<std::string, uint16_t> slots;
+    std::size_t loop_depth = 0;
+};
+
+Program compile(const std::vector<std::unique_ptr<Instruction>>& src);
@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models", PPoPP'13).
+// push()/pop() may only be called by the owning thread; steal() by anyone.
+// T must be trivially copyable (the scheduler stores raw Process*).
+template <typename T>
+class ChaseLevDeque {
+    struct Ring {
+        int64_t cap;
+        std::unique_ptr<std::atomic<T>[]> slots;
+        explicit Ring(int64_t c) : cap(c), slots(new std::atomic<T>[c]) {}
+        T    get(int64_t i) const { return slots[i & (cap - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, T v)  { slots[i & (cap - 1)].store(v, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Ring*> ring;
+    // thieves may still read a replaced ring, so old rings live as long as the deque
+    std::vector<std::unique_ptr<Ring>> rings;
+
+public:
+    explicit ChaseLevDeque(int64_t capacity = 64)
+    {
+        int64_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        rings.emplace_back(std::make_unique<Ring>(cap));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    void push(T v)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Ring* r = ring.load(std::memory_order_relaxed);
+        if (b - t > r->cap - 1) {
+            auto bigger = std::make_unique<Ring>(r->cap * 2);
+            for (int64_t i = t; i < b; ++i) bigger->put(i, r->get(i));
+            r = bigger.get();
+            rings.push_back(std::move(bigger));
+            ring.store(r, std::memory_order_release);
+        }
+        r->put(b, v);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    bool pop(T& out)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_seq_cst);
+        if (t > b) {                                   // empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = r->get(b);
+        if (t == b) {                                  // last element: race thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    bool steal(T& out)
+    {
+        int64_t t = top.load(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b) return false;
+        Ring* r = ring.load(std::memory_order_acquire);
+        T v = r->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+            return false;                              // lost the race, caller retries
+        out = v;
+        return true;
+    }
+
+    bool empty() const
+    {
+        return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+    }
+};
@@ -1,4 +1,5 @@
 #include "config_manager.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -41,8 +42,9 @@ bool ConfigManager::load(const std::string& filename)
             if (v < 1 || v > 128) { std::cerr << "num-cpu must be [1,128]\n"; return false; }
         }
         else if (key == "scheduler") {
-            if (value != "fcfs" && value != "rr") {
-                std::cerr << "scheduler must be fcfs or rr\n"; return false;
+            if (value != "fcfs" && value != "rr" && value != "ws" && value != "mlfq"
+                && value != "sjf" && value != "srtf") {
+                std::cerr << "scheduler must be fcfs, rr, ws, mlfq, sjf or srtf\n"; return false;
             }
         }
         else if (key == "quantum-cycles") {
@@ -69,6 +71,58 @@ bool ConfigManager::load(const std::string& filename)
                 std::cerr << "max-ins out of range\n"; return false;
             }
         }
+        else if (key == "tick-duration") {
+            unsigned long long v = std::stoull(value);     // ms per tick, 0 = unpaced
+            if (v > UINT32_MAX) {
+                std::cerr << "tick-duration out of range\n"; return false;
+            }
+        }
+        else if (key == "program-pool") {
+            unsigned long long v = std::stoull(value);
+            if (v == 0 || v > UINT32_MAX) {
+                std::cerr << "program-pool out of range\n"; return false;
+            }
+        }
+        else if (key == "log-open-files") {
+            unsigned long long v = std::stoull(value);
+            if (v == 0 || v > 65536) {
+                std::cerr << "log-open-files out of range\n"; return false;
+            }
+        }
+        else if (key == "seed") {
+            unsigned long long v = std::stoull(value);     // workload RNG seed
+            if (v > UINT32_MAX) {
+                std::cerr << "seed out of range\n"; return false;
+            }
+        }
+        else if (key == "mlfq-levels") {
+            unsigned long long v = std::stoull(value);
+            if (v == 0 || v > 16) {
+                std::cerr << "mlfq-levels must be [1,16]\n"; return false;
+            }
+        }
+        else if (key == "mlfq-quanta") {
+            // comma-separated, one quantum per level: "2,4,8"
+            std::istringstream list(value);
+            std::string q;
+            std::size_t n = 0;
+            while (std::getline(list, q, ',')) {
+                if (q.empty() || q.find_first_not_of("0123456789") != std::string::npos
+                    || q.size() > 9 || std::stoull(q) == 0) {
+                    std::cerr << "mlfq-quanta must be comma-separated positive integers\n"; return false;
+                }
+                ++n;
+            }
+            if (n == 0 || n > 16) {
+                std::cerr << "mlfq-quanta must list 1 to 16 levels\n"; return false;
+            }
+        }
+        else if (key == "mlfq-boost") {
+            unsigned long long v = std::stoull(value);     // cycles, 0 = never
+            if (v > UINT32_MAX) {
+                std::cerr << "mlfq-boost out of range\n"; return false;
+            }
+        }
         else if (key == "delays-per-exec") {
             unsigned long long v = std::stoull(value);     // 0 -- 2³²-1 allowed
             if (v > UINT32_MAX) {
@@ -91,10 +145,17 @@ bool ConfigManager::load(const std::string& filename)
             std::cerr << "Missing config key: " << k << '\n'; return false;
         }
 
-    if (values["scheduler"] == "rr" && values.count("quantum-cycles") == 0) {
-        std::cerr << "Missing config key: quantum-cycles (required for rr)\n";
+    if (values["scheduler"] != "fcfs" && values.count("quantum-cycles") == 0) {
+        std::cerr << "Missing config key: quantum-cycles (required for rr, ws and mlfq)\n";
         return false;
     }
+    if (values.count("mlfq-levels") && values.count("mlfq-quanta")) {
+        const auto& quanta = values["mlfq-quanta"];
+        const auto  n = std::count(quanta.begin(), quanta.end(), ',') + 1;
+        if (std::stoull(values["mlfq-levels"]) != static_cast<unsigned long long>(n)) {
+            std::cerr << "mlfq-levels must match the number of mlfq-quanta\n"; return false;
+        }
+    }
     auto mi = std::stoul(values["min-ins"]);
     auto ma = std::stoul(values["max-ins"]);
     if (mi > ma) {
@@ -111,7 +172,19 @@ std::string ConfigManager::get(const std::string &key) const
     return it->second;
 }
 
+std::string ConfigManager::get_or(const std::string &key, const std::string &fallback) const
+{
+    auto it = values.find(key);
+    return it == values.end() ? fallback : it->second;
+}
+
 uint64_t ConfigManager::get_long(const std::string &key) const
 {
     return std::stoull(get(key));
 }
+
+uint64_t ConfigManager::get_long(const std::string &key, uint64_t fallback) const
+{
+    auto it = values.find(key);
+    return it == values.end() ? fallback : std::stoull(it->second);
+}
@@ -11,8 +11,12 @@ inline constexpr bool kTestMode = false;
 class ConfigManager {
 public:
     bool      load(const std::string& filename);
+    // overrides a key after load(), e.g. from the command line; not validated
+    void      set(const std::string& key, const std::string& value) { values[key] = value; }
     std::string get(const std::string& key)        const;
+    std::string get_or(const std::string& key, const std::string& fallback) const;
     uint64_t    get_long(const std::string& key)   const;
+    uint64_t    get_long(const std::string& key, uint64_t fallback) const;
 private:
     std::unordered_map<std::string,std::string> values;
 };
\ No newline at end of file
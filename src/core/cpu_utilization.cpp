@@ -2,66 +2,115 @@
 #include <iostream>
 #include <fstream>
 #include <atomic>
+#include <chrono>
 #include <algorithm>
 #include <iomanip>
 
 std::atomic<uint64_t> cpu_cycles_counter{0};
 
 CPUUtilization::CPUUtilization(uint32_t total_cores)
-    : total_cores_(total_cores),
-      start_times(total_cores),
-      busy_times(total_cores),
-      is_busy(total_cores,false),
-      busy_cores_(0),
-      t0(std::chrono::steady_clock::now())
-{}
+    : cores_(new CoreStats[total_cores]),
+      total_cores_(total_cores)
+{
+    const int64_t start = now_ns();
+    for (uint32_t c = 0; c < total_cores_; ++c)
+        cores_[c].since_ns.store(start, std::memory_order_relaxed);
+}
+
+int64_t CPUUtilization::now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
+// Only the core's own worker marks it, so the read-modify-write sequences
+// below need no CAS; readers may see a transition half-applied, which only
+// shifts one interval between the busy and idle totals.
 void CPUUtilization::mark_busy(int core)
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    if (!is_busy[core]) {          // first time this quantum
-        is_busy[core] = true;
-        ++busy_cores_;
-    }
+    auto& c = cores_[core];
+    if (c.busy.load(std::memory_order_relaxed)) return;
+    const int64_t now = now_ns();
+    c.idle_ns.fetch_add(now - c.since_ns.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    c.since_ns.store(now, std::memory_order_relaxed);
+    c.busy.store(true, std::memory_order_release);
 }
 
 void CPUUtilization::mark_idle(int core)
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    if (is_busy[core]) {           // only once per quantum
-        is_busy[core] = false;
-        --busy_cores_;
-    }
+    auto& c = cores_[core];
+    if (!c.busy.load(std::memory_order_relaxed)) return;
+    const int64_t now = now_ns();
+    c.busy_ns.fetch_add(now - c.since_ns.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    c.since_ns.store(now, std::memory_order_relaxed);
+    c.busy.store(false, std::memory_order_release);
+}
+
+void CPUUtilization::add_ticks(int core, uint64_t n)
+{
+    cores_[core].busy_ticks.fetch_add(n, std::memory_order_relaxed);
 }
 
 int CPUUtilization::get_busy_cores() const
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    return static_cast<int>(busy_cores_);
+    int busy = 0;
+    for (uint32_t c = 0; c < total_cores_; ++c)
+        busy += cores_[c].busy.load(std::memory_order_acquire);
+    return busy;
 }
 
 int CPUUtilization::get_available_cores() const
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    return static_cast<int>(total_cores_ - busy_cores_);
+    return static_cast<int>(total_cores_) - get_busy_cores();
 }
 
 double CPUUtilization::get_utilization_percent() const
 {
-    std::lock_guard<std::mutex> lk(mtx);
     return total_cores_ == 0
          ? 0.0
-         : (busy_cores_ * 100.0) / static_cast<double>(total_cores_);
+         : (get_busy_cores() * 100.0) / static_cast<double>(total_cores_);
 }
 
 int CPUUtilization::get_total_cores() const {
     return static_cast<int>(total_cores_);
 }
 
+UtilizationSample CPUUtilization::sample() const
+{
+    UtilizationSample s;
+    s.total_cores = static_cast<int>(total_cores_);
+    s.core_percent.resize(total_cores_);
+    s.core_busy_ns.resize(total_cores_);
+
+    const int64_t now = now_ns();
+    s.taken_ns = now;
+    double busy_sum = 0.0, total_sum = 0.0;
+    for (uint32_t i = 0; i < total_cores_; ++i) {
+        const auto& c = cores_[i];
+        const bool    busy  = c.busy.load(std::memory_order_acquire);
+        const int64_t open  = std::max<int64_t>(0, now - c.since_ns.load(std::memory_order_relaxed));
+        const double  b = static_cast<double>(c.busy_ns.load(std::memory_order_relaxed)) + (busy ? open : 0);
+        const double  d = static_cast<double>(c.idle_ns.load(std::memory_order_relaxed)) + (busy ? 0 : open);
+        s.busy_cores += busy;
+        s.busy_ticks += c.busy_ticks.load(std::memory_order_relaxed);
+        s.core_percent[i] = (b + d) > 0 ? b * 100.0 / (b + d) : 0.0;
+        s.core_busy_ns[i] = static_cast<uint64_t>(b);
+        busy_sum  += b;
+        total_sum += b + d;
+    }
+    s.instant_percent  = total_cores_ ? s.busy_cores * 100.0 / total_cores_ : 0.0;
+    s.weighted_percent = total_sum > 0 ? busy_sum * 100.0 / total_sum : 0.0;
+    return s;
+}
+
 void CPUUtilization::print_report(std::ostream& out) const
 {
+    const auto s = sample();
     out << "CPU utilization: " << std::fixed << std::setprecision(1)
-        << get_utilization_percent() << "%\n"
-        << "Cores used: "      << get_busy_cores()      << '\n'
-        << "Cores available: " << get_available_cores() << '\n';
-}
\ No newline at end of file
+        << s.instant_percent << "%\n"
+        << "Average utilization: " << s.weighted_percent << "%\n"
+        << "Cores used: "      << s.busy_cores      << '\n'
+        << "Cores available: " << (s.total_cores - s.busy_cores) << '\n';
+}
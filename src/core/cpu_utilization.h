@@ -1,25 +1,50 @@
 #pragma once
-#include <chrono>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <ostream>
 
+// global emulated clock, in core-ticks: every core adds one cycle per
+// instruction it executes, so busy cores advance it num-cpu times as fast
+extern std::atomic<uint64_t> cpu_cycles_counter;
+
+// One lock-free reading of every core's counters.
+struct UtilizationSample {
+    int      total_cores = 0;
+    int      busy_cores  = 0;
+    double   instant_percent  = 0.0;   // busy cores right now
+    double   weighted_percent = 0.0;   // busy time / wall time since start
+    uint64_t busy_ticks = 0;           // instruction ticks executed, all cores
+    std::vector<double> core_percent;  // time-weighted, per core
+    std::vector<uint64_t> core_busy_ns; // cumulative, per core
+    int64_t  taken_ns = 0;             // steady-clock time of the sample
+};
+
+// Per-core busy/idle accounting. Each core only writes its own cache line,
+// so marking and counting never contend; readers sample without locks.
 class CPUUtilization {
 public:
     explicit  CPUUtilization(uint32_t cores);
     void      mark_busy(int core);
     void      mark_idle(int core);
+    void      add_ticks(int core, uint64_t n);
     int       get_busy_cores()        const;
     int       get_available_cores()   const;
     double    get_utilization_percent() const;
     int       get_total_cores()       const;
+    UtilizationSample sample()        const;
     void      print_report(std::ostream&) const;
 private:
-    mutable std::mutex mtx;
-    std::vector<std::chrono::steady_clock::time_point> start_times;
-    std::vector<std::chrono::nanoseconds>             busy_times;
-    std::vector<bool>                                 is_busy;
-    std::chrono::steady_clock::time_point             t0;
-    uint32_t                                          total_cores_;
-    uint32_t                         busy_cores_{0};
-};
\ No newline at end of file
+    struct alignas(64) CoreStats {
+        std::atomic<bool>     busy{false};
+        std::atomic<int64_t>  since_ns{0};     // last busy/idle transition
+        std::atomic<uint64_t> busy_ns{0};
+        std::atomic<uint64_t> idle_ns{0};
+        std::atomic<uint64_t> busy_ticks{0};
+    };
+    static int64_t now_ns();
+
+    std::unique_ptr<CoreStats[]> cores_;
+    uint32_t total_cores_;
+};
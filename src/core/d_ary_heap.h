@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Array-backed d-ary min-heap. Four children per node halve the depth of a
+// binary heap and keep siblings adjacent in memory, which suits a run queue
+// that is pushed and popped in roughly equal measure. Not synchronized; the
+// owning scheduler guards it.
+template <typename T, typename Less = std::less<T>, std::size_t D = 4>
+class DaryHeap {
+    static_assert(D >= 2, "a heap node needs at least two children");
+    std::vector<T> v;
+    Less less;
+
+    void sift_up(std::size_t i)
+    {
+        T x = std::move(v[i]);
+        while (i > 0) {
+            const std::size_t parent = (i - 1) / D;
+            if (!less(x, v[parent])) break;
+            v[i] = std::move(v[parent]);
+            i = parent;
+        }
+        v[i] = std::move(x);
+    }
+
+    void sift_down(std::size_t i)
+    {
+        const std::size_t n = v.size();
+        T x = std::move(v[i]);
+        for (;;) {
+            const std::size_t first = i * D + 1;
+            if (first >= n) break;
+            std::size_t best = first;
+            const std::size_t last = first + D < n ? first + D : n;
+            for (std::size_t c = first + 1; c < last; ++c)
+                if (less(v[c], v[best])) best = c;
+            if (!less(v[best], x)) break;
+            v[i] = std::move(v[best]);
+            i = best;
+        }
+        v[i] = std::move(x);
+    }
+
+public:
+    bool        empty() const { return v.empty(); }
+    std::size_t size()  const { return v.size(); }
+    const T&    top()   const { return v.front(); }
+    void        clear()       { v.clear(); }
+
+    void push(T x)
+    {
+        v.push_back(std::move(x));
+        sift_up(v.size() - 1);
+    }
+
+    T pop()
+    {
+        T out = std::move(v.front());
+        if (v.size() > 1) {
+            v.front() = std::move(v.back());
+            v.pop_back();
+            sift_down(0);
+        } else {
+            v.pop_back();
+        }
+        return out;
+    }
+};
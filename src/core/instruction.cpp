@@ -1,49 +1,56 @@
 #include "instruction.h"
-#include "process.h"
-#include "time_utils.h"
-#include <sstream>
-#include <cctype>
+#include "bytecode.h"
 
-extern std::string now_time();
-
-void PrintInst::execute(Process& p)
+void PrintInst::compile(ProgramBuilder& b) const
 {
-    std::ostringstream oss;
-    oss << "(" << util::now_time() << ") Core:"  
-        << p.get_core_id() << " \"" << msg << "\"";
+    b.emit(Bytecode{Op::PRINT});
 }
 
-void DeclInst::execute(Process& p) { 
-    p.set_var(var, value);
+void DeclInst::compile(ProgramBuilder& b) const
+{
+    Bytecode bc{Op::DECL};
+    bc.dst   = b.slot(var);
+    bc.flags = Bytecode::A_IMM;
+    bc.a     = static_cast<uint16_t>(value < 0 ? 0 : value > 65535 ? 65535 : value);
+    b.emit(bc);
 }
 
-void MathInst::execute(Process& p) {
-    int a = p.get_var_or_val(op1);
-    int b = p.get_var_or_val(op2);
-    long long res64 = is_add ? (static_cast<long long>(a) + b)
-                             : (static_cast<long long>(a) - b);
-    if (res64 < 0)     res64 = 0;
-    if (res64 > 65535) res64 = 65535;
-    p.set_var(dest, static_cast<int>(res64));
+void MathInst::compile(ProgramBuilder& b) const
+{
+    Bytecode bc{is_add ? Op::ADD : Op::SUB};
+    if (b.operand(op1, bc.a)) bc.flags |= Bytecode::A_IMM;
+    if (b.operand(op2, bc.b)) bc.flags |= Bytecode::B_IMM;
+    bc.dst = b.slot(dest);
+    b.emit(bc);
 }
 
-void SleepInst::execute(Process& p) {
-    p.sleep(ticks);
+void SleepInst::compile(ProgramBuilder& b) const
+{
+    Bytecode bc{Op::SLEEP};
+    bc.imm = static_cast<uint32_t>(ticks < 0 ? 0 : ticks);
+    b.emit(bc);
 }
 
-void ForInst::execute(Process& p) {
-    if (repeats <= 0) return; 
-    if (current < repeats) {
-        if (index < body.size()) {
-            body[index++]->execute(p);
-        } else {
-            ++current; index = 0;
-        }
-    }
+// FOR <body> END. The counter lives on the process's loop stack, so the
+// compiled program stays immutable and shareable.
+void ForInst::compile(ProgramBuilder& b) const
+{
+    b.enter_loop();
+    const uint32_t head = b.here();
+    Bytecode bc{Op::FOR};
+    bc.a = static_cast<uint16_t>(repeats < 0 ? 0 : repeats > 65535 ? 65535 : repeats);
+    b.emit(bc);
+    for (const auto& inst : body)
+        inst->compile(b);
+    Bytecode end{Op::END};
+    end.imm = head + 1;
+    b.emit(end);
+    b.at(head).imm = b.here();
+    b.leave_loop();
 }
 
 const char* PrintInst::tag() const  { return "PRINT"; }
 const char* DeclInst::tag()  const  { return "DECL";  }
 const char* MathInst::tag()  const  { return is_add ? "ADD" : "SUB"; }
 const char* SleepInst::tag() const  { return "SLEEP"; }
-const char* ForInst::tag()   const  { return "FOR";   }
\ No newline at end of file
+const char* ForInst::tag()   const  { return "FOR";   }
@@ -3,34 +3,34 @@
 #include <vector>
 #include <memory>
 
-class Process;            
+class ProgramBuilder;
 
+// Source-level instruction tree built by the program generator. It is
+// lowered once into a flat Program (see bytecode.h) and then discarded.
 class Instruction {
 public:
     virtual ~Instruction() = default;
 
-    // run one step on a Process
-    virtual void execute(Process&) = 0;
+    // append this instruction's bytecode
+    virtual void compile(ProgramBuilder&) const = 0;
 
-    // short opcode name for logging  (NEW)
+    // short opcode name for logging
     virtual const char* tag() const = 0;
 };
 
 
+// PRINT carries no text: a PRINT tick is logged by its tag alone
 class PrintInst : public Instruction {
-    std::string msg;
 public:
-    explicit PrintInst(std::string m) : msg(std::move(m)) {}
-    void        execute(Process& p) override;
+    void        compile(ProgramBuilder& b) const override;
     const char* tag() const override;             // "PRINT"
-    const std::string& get_msg() const { return msg; }
 };
 
 class DeclInst : public Instruction {
     std::string var; int value;
 public:
     DeclInst(std::string v, int val) : var(std::move(v)), value(val) {}
-    void        execute(Process& p) override;
+    void        compile(ProgramBuilder& b) const override;
     const char* tag() const override;             // "DECL"
 };
 
@@ -40,7 +40,7 @@ class MathInst : public Instruction {
 public:
     MathInst(std::string d,std::string a,std::string b,bool add)
         : dest(std::move(d)), op1(std::move(a)), op2(std::move(b)), is_add(add) {}
-    void        execute(Process& p) override;
+    void        compile(ProgramBuilder& b) const override;
     const char* tag() const override;             // "ADD"/"SUB"
 };
 
@@ -48,16 +48,16 @@ class SleepInst : public Instruction {
     int ticks;
 public:
     explicit SleepInst(int t) : ticks(t) {}
-    void        execute(Process& p) override;
+    void        compile(ProgramBuilder& b) const override;
     const char* tag() const override;             // "SLEEP"
 };
 
 class ForInst : public Instruction {
-    int repeats, current = 0, index = 0;
+    int repeats;
     std::vector<std::unique_ptr<Instruction>> body;
 public:
     ForInst(int r, std::vector<std::unique_ptr<Instruction>> b)
         : repeats(r), body(std::move(b)) {}
-    void        execute(Process& p) override;
+    void        compile(ProgramBuilder& b) const override;
     const char* tag() const override;             // "FOR"
 };
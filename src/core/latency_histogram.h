@@ -0,0 +1,95 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Log-linear histogram in the style of HdrHistogram. Values are grouped by
+// power of two and each group is split into 2^kSubBits linear sub-buckets,
+// so any recorded value is reported within ~3% over the whole uint64 range
+// in fixed memory. record() is a handful of relaxed atomic ops, so worker
+// threads can share one instance; readers see a slightly stale snapshot.
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBits = 5;
+    static constexpr unsigned kSub     = 1u << kSubBits;
+    static constexpr unsigned kBuckets = (64 - kSubBits + 1) * kSub;
+
+    void record(uint64_t v)
+    {
+        counts[index(v)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(v, std::memory_order_relaxed);
+        uint64_t m = max_v.load(std::memory_order_relaxed);
+        while (v > m && !max_v.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max()   const { return max_v.load(std::memory_order_relaxed); }
+    double   mean()  const
+    {
+        const uint64_t n = count();
+        return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    // smallest bucket bound at or below which p percent of values fall
+    uint64_t percentile(double p) const
+    {
+        const uint64_t n = count();
+        if (n == 0) return 0;
+        const auto want = std::max<uint64_t>(1, static_cast<uint64_t>(p / 100.0 * n + 0.999999));
+        uint64_t seen = 0;
+        for (unsigned i = 0; i < kBuckets; ++i) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen >= want) return std::min(highest_in(i), max());
+        }
+        return max();
+    }
+
+private:
+    static unsigned index(uint64_t v)
+    {
+        if (v < kSub) return static_cast<unsigned>(v);
+        const unsigned shift = highest_bit(v) - kSubBits;
+        return (shift + 1) * kSub + static_cast<unsigned>((v >> shift) - kSub);
+    }
+
+    // position of the top set bit; v != 0
+    static unsigned highest_bit(uint64_t v)
+    {
+#if defined(__cpp_lib_bitops)
+        return 63u - static_cast<unsigned>(std::countl_zero(v));
+#elif defined(__GNUC__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#elif defined(_MSC_VER)
+        unsigned long i;
+        _BitScanReverse64(&i, v);
+        return static_cast<unsigned>(i);
+#else
+        unsigned i = 0;
+        for (unsigned step = 32; step; step /= 2)
+            if (v >> step) { v >>= step; i += step; }
+        return i;
+#endif
+    }
+
+    static uint64_t highest_in(unsigned i)
+    {
+        const unsigned group = i / kSub, sub = i % kSub;
+        if (group == 0) return sub;
+        const unsigned shift = group - 1;
+        if (shift + kSubBits + 1 >= 64 && sub == kSub - 1)
+            return std::numeric_limits<uint64_t>::max();
+        return ((uint64_t(kSub + sub + 1)) << shift) - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> counts{};
+    std::atomic<uint64_t> total{0}, sum{0}, max_v{0};
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+// Fixed-capacity history of trivially copyable log records stored inline.
+// Not synchronized; the owner guards it. Readers take a View: a flat copy of
+// the newest records that can be walked after the owner's lock is released,
+// without any heap allocation.
+template <typename T, std::size_t N>
+class LogRing {
+    static_assert(std::is_trivially_copyable_v<T>, "records are copied raw");
+    std::array<T, N> slots{};
+    std::size_t next  = 0;          // slot the next push overwrites
+    std::size_t count = 0;
+
+public:
+    static constexpr std::size_t capacity = N;
+
+    void push(const T& rec)
+    {
+        slots[next] = rec;
+        next = (next + 1) % N;
+        if (count < N) ++count;
+    }
+
+    std::size_t size() const { return count; }
+
+    // newest `n` records, oldest first
+    class View {
+        std::array<T, N> recs;
+        std::size_t      n;
+    public:
+        View(const LogRing& r, std::size_t want) : n(std::min(want, r.count))
+        {
+            const std::size_t first = (r.next + N - n) % N;
+            for (std::size_t i = 0; i < n; ++i)
+                recs[i] = r.slots[(first + i) % N];
+        }
+        std::size_t size() const { return n; }
+        const T& operator[](std::size_t i) const { return recs[i]; }
+        const T* begin() const { return recs.data(); }
+        const T* end()   const { return recs.data() + n; }
+    };
+
+    View recent(std::size_t n) const { return View(*this, n); }
+};
@@ -0,0 +1,193 @@
+#include "log_writer.h"
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+LogWriter::LogWriter(uint32_t cores, std::size_t max_open_, std::string dir_)
+    : dir(std::move(dir_)), max_open(std::max<std::size_t>(1, max_open_))
+{
+    for (uint32_t i = 0; i < cores; ++i)
+        rings.push_back(std::make_unique<Ring>());
+    worker = std::thread([this] { run(); });
+}
+
+LogWriter::~LogWriter()
+{
+    stopping = true;
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void LogWriter::append(int core, const std::string& name, uint64_t seq, const TraceRecord& rec)
+{
+    push(core, Entry{name, rec, seq, false});
+}
+
+void LogWriter::close(int core, const std::string& name, uint64_t seq)
+{
+    push(core, Entry{name, {}, seq, true});
+}
+
+void LogWriter::push(int core, Entry e)
+{
+    if (core < 0 || core >= static_cast<int>(rings.size())) {
+        std::lock_guard<std::mutex> lk(side_mtx);
+        side.push_back(std::move(e));
+        return;
+    }
+    Ring& r = *rings[core];
+    const std::size_t t = r.tail.load(std::memory_order_relaxed);
+    // ring full: wait for the writer instead of dropping records
+    while (t - r.head.load(std::memory_order_acquire) == Ring::kSize) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+    r.slots[t & (Ring::kSize - 1)] = std::move(e);
+    r.tail.store(t + 1, std::memory_order_release);
+    if (t - r.head.load(std::memory_order_relaxed) == Ring::kSize / 2)
+        wake.notify_one();
+}
+
+// Places one entry into its file's in-order batch, holding it back if an
+// earlier record is still sitting in another core's ring.
+void LogWriter::accept(Entry e)
+{
+    FileState& f = files[e.name];
+    if (!f.dirty) { f.dirty = true; dirty.push_back(e.name); }
+    if (e.seq != f.next) {
+        const uint64_t seq = e.seq;
+        f.held.emplace(seq, std::move(e));
+        return;
+    }
+    for (;;) {
+        ++f.next;
+        if (e.close) f.closing = true;
+        else         f.ready.push_back(e.rec);
+        auto it = f.held.find(f.next);
+        if (it == f.held.end()) break;
+        e = std::move(it->second);
+        f.held.erase(it);
+    }
+}
+
+// Moves everything queued into per-file batches, then writes them out.
+bool LogWriter::drain()
+{
+    bool any = false;
+    for (auto& rp : rings) {
+        Ring& r = *rp;
+        std::size_t h = r.head.load(std::memory_order_relaxed);
+        const std::size_t t = r.tail.load(std::memory_order_acquire);
+        for (; h != t; ++h) {
+            Entry& e = r.slots[h & (Ring::kSize - 1)];
+            accept(std::move(e));
+            e = Entry{};
+            any = true;
+        }
+        r.head.store(h, std::memory_order_release);
+    }
+    {
+        std::deque<Entry> batch;
+        { std::lock_guard<std::mutex> lk(side_mtx); batch.swap(side); }
+        for (auto& e : batch) { accept(std::move(e)); any = true; }
+    }
+
+    for (const auto& name : dirty) {
+        auto it = files.find(name);
+        if (it == files.end()) continue;
+        flush(name, it->second.ready);
+        it->second.dirty = false;
+        if (it->second.closing) {
+            close_fd(name);
+            files.erase(it);
+        }
+    }
+    dirty.clear();
+    return any;
+}
+
+void LogWriter::run()
+{
+    for (;;) {
+        const bool stop = stopping.load();
+        const bool any  = drain();
+        if (stop) break;
+        if (!any) {
+            std::unique_lock<std::mutex> lk(wake_mtx);
+            wake.wait_for(lk, std::chrono::milliseconds(5));
+        }
+    }
+    while (!lru.empty()) close_fd(lru.back());
+}
+
+static void write_all(int fd, const void* data, std::size_t len)
+{
+    auto p = static_cast<const char*>(data);
+    while (len > 0) {
+#ifdef _WIN32
+        int n = _write(fd, p, static_cast<unsigned>(len));
+#else
+        ssize_t n = ::write(fd, p, len);
+#endif
+        if (n <= 0) return;          // best effort, like the std::ofstream it replaced
+        p   += n;
+        len -= static_cast<std::size_t>(n);
+    }
+}
+
+void LogWriter::flush(const std::string& name, std::vector<TraceRecord>& recs)
+{
+    if (recs.empty()) return;
+    int fd = fd_for(name);
+    if (fd >= 0)
+        write_all(fd, recs.data(), recs.size() * sizeof(TraceRecord));
+    recs.clear();
+}
+
+int LogWriter::fd_for(const std::string& name)
+{
+    auto it = open_files.find(name);
+    if (it != open_files.end()) {
+        lru.splice(lru.begin(), lru, it->second.lru);
+        return it->second.fd;
+    }
+    if (open_files.size() >= max_open)
+        close_fd(lru.back());
+    const std::string path = dir + "/" + name + ".bin";
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT, 0644);
+#else
+    int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#endif
+    if (fd < 0) return -1;
+#ifdef _WIN32
+    const bool fresh = _lseek(fd, 0, SEEK_END) == 0;
+#else
+    const bool fresh = ::lseek(fd, 0, SEEK_END) == 0;
+#endif
+    if (fresh) {
+        TraceFileHeader hdr;
+        write_all(fd, &hdr, sizeof hdr);
+    }
+    lru.push_front(name);
+    open_files.emplace(name, Open{fd, lru.begin()});
+    return fd;
+}
+
+void LogWriter::close_fd(const std::string& name)
+{
+    auto it = open_files.find(name);
+    if (it == open_files.end()) return;
+#ifdef _WIN32
+    _close(it->second.fd);
+#else
+    ::close(it->second.fd);
+#endif
+    lru.erase(it->second.lru);
+    open_files.erase(it);
+}
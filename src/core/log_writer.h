@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "trace.h"
+
+// Asynchronous per-process binary trace files (logs/<name>.bin, see trace.h).
+// Each core appends to its own single-producer ring; one background thread
+// drains the rings, groups records by file and writes each group with a
+// single write. At most max_open files stay open (LRU); a file is closed
+// when its process ends.
+// A process can migrate between cores, so every entry carries a per-process
+// sequence number and the writer restores that order before writing.
+// csopesy-logdump renders the files back to text.
+class LogWriter {
+public:
+    LogWriter(uint32_t cores, std::size_t max_open, std::string dir = "logs");
+    ~LogWriter();
+
+    // queue record number `seq` (0, 1, 2, ...) for logs/<name>.bin;
+    // core < 0 uses a locked side queue
+    void append(int core, const std::string& name, uint64_t seq, const TraceRecord& rec);
+    // close logs/<name>.bin after records 0..seq-1 are written
+    void close(int core, const std::string& name, uint64_t seq);
+
+private:
+    struct Entry {
+        std::string name;
+        TraceRecord rec;
+        uint64_t    seq   = 0;
+        bool        close = false;
+    };
+    struct Ring {
+        static constexpr std::size_t kSize = 1024;   // power of two
+        alignas(64) std::atomic<std::size_t> head{0};   // consumer
+        alignas(64) std::atomic<std::size_t> tail{0};   // producer
+        Entry slots[kSize];
+    };
+    struct Open {
+        int fd;
+        std::list<std::string>::iterator lru;
+    };
+    struct FileState {
+        uint64_t                 next = 0;    // next seq to write
+        std::vector<TraceRecord> ready;       // in order, not yet written
+        std::map<uint64_t, Entry> held;       // arrived ahead of `next`
+        bool                     closing = false;
+        bool                     dirty   = false;  // listed in `dirty`
+    };
+
+    void push(int core, Entry e);
+    void run();
+    bool drain();
+    void accept(Entry e);
+    void flush(const std::string& name, std::vector<TraceRecord>& recs);
+    int  fd_for(const std::string& name);
+    void close_fd(const std::string& name);
+
+    std::string dir;
+    std::size_t max_open;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::mutex side_mtx;
+    std::deque<Entry> side;
+
+    // writer-thread state
+    std::unordered_map<std::string, FileState> files;
+    std::vector<std::string> dirty;                  // files with ready records
+    std::unordered_map<std::string, Open> open_files;
+    std::list<std::string> lru;                      // front = most recent
+
+    std::mutex              wake_mtx;
+    std::condition_variable wake;
+    std::atomic<bool>       stopping{false};
+    std::thread             worker;
+};
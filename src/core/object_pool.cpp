@@ -0,0 +1,55 @@
+#include "object_pool.h"
+
+PoolArena& PoolArena::instance()
+{
+    // never destroyed: pooled objects may outlive every other static
+    static PoolArena* arena = new PoolArena;
+    return *arena;
+}
+
+void* PoolArena::allocate(std::size_t bytes)
+{
+    if (bytes == 0) bytes = 1;
+    if (bytes > kMaxBlock) return ::operator new(bytes);
+
+    SizeClass& c = classes[(bytes - 1) / kAlign];
+    std::lock_guard<std::mutex> lk(c.mtx);
+    if (!c.free) {
+        // carve a new slab into blocks of this class
+        const std::size_t block = ((bytes - 1) / kAlign + 1) * kAlign;
+        const std::size_t n = kSlabBytes / block;
+        auto* slab = static_cast<std::byte*>(::operator new(n * block));
+        c.slabs.push_back(slab);
+        for (std::size_t i = n; i-- > 0;)
+            c.free = new (slab + i * block) FreeBlock{c.free};
+    }
+    FreeBlock* b = c.free;
+    c.free = b->next;
+    ++c.live;
+    return b;
+}
+
+void PoolArena::deallocate(void* p, std::size_t bytes) noexcept
+{
+    if (!p) return;
+    if (bytes == 0) bytes = 1;
+    if (bytes > kMaxBlock) { ::operator delete(p); return; }
+
+    SizeClass& c = classes[(bytes - 1) / kAlign];
+    std::lock_guard<std::mutex> lk(c.mtx);
+    c.free = new (p) FreeBlock{c.free};
+    --c.live;
+}
+
+PoolArena::Stats PoolArena::stats() const
+{
+    Stats s;
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        const SizeClass& c = classes[i];
+        std::lock_guard<std::mutex> lk(c.mtx);
+        const std::size_t block = (i + 1) * kAlign;
+        s.reserved_bytes += c.slabs.size() * (kSlabBytes / block) * block;
+        s.live_blocks    += c.live;
+    }
+    return s;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Per-size-class free lists for the small objects a process churns through:
+// the Process itself (see make_pooled), its registry index nodes and the
+// ready-queue chunks that hold it. A freed block goes back on its class's
+// list and the next allocation of that size takes it, so once the pools
+// cover the working set, admitting and retiring processes stops touching
+// the heap. Slabs are never returned; the arena lives for the whole program
+// so blocks may be freed from any thread at any time, including exit.
+class PoolArena {
+public:
+    static constexpr std::size_t kAlign     = 16;
+    static constexpr std::size_t kMaxBlock  = 2048;         // larger requests use operator new
+    static constexpr std::size_t kSlabBytes = 64 * 1024;
+
+    static PoolArena& instance();
+
+    void* allocate(std::size_t bytes);
+    void  deallocate(void* p, std::size_t bytes) noexcept;
+
+    struct Stats {
+        std::size_t reserved_bytes = 0;    // carved into blocks so far
+        std::size_t live_blocks    = 0;    // handed out and not yet freed
+    };
+    Stats stats() const;
+
+private:
+    PoolArena() = default;
+
+    struct FreeBlock { FreeBlock* next; };
+    struct alignas(64) SizeClass {
+        mutable std::mutex mtx;
+        FreeBlock* free = nullptr;
+        std::size_t live = 0;
+        std::vector<void*> slabs;          // kept so the memory stays reachable
+    };
+    std::array<SizeClass, kMaxBlock / kAlign> classes;
+};
+
+// Stateless allocator drawing from PoolArena::instance(); usable with
+// std::allocate_shared and the standard node and deque containers.
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template <typename U> PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if constexpr (alignof(T) > PoolArena::kAlign)
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        else
+            return static_cast<T*>(PoolArena::instance().allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if constexpr (alignof(T) > PoolArena::kAlign)
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        else
+            PoolArena::instance().deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+// make_shared with the object and its control block in one pooled block
+template <typename T, typename... Args>
+std::shared_ptr<T> make_pooled(Args&&... args)
+{
+    return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<Args>(args)...);
+}
@@ -1,14 +1,16 @@
 #include "process.h"
-#include "instruction.h"
+#include "bytecode.h"
 #include "config_manager.h"
 #include "time_utils.h"
+#include "cpu_utilization.h"
 #include <chrono>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
-#include <random>
 #include <sstream>
 #include <algorithm>
 #include <unordered_map>
@@ -33,104 +35,131 @@
 // }
 
 Process::Process(std::string name_, int id_,
-                 int min_ins, int max_ins, int delay)
-    : name(std::move(name_)), id(id_)
-{
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<int> icount(min_ins, max_ins);
-
-    const int N = icount(rng);              
-    int var_count = 0;                      
-    std::vector<std::string> var_names;    
-
-    for (int i = 0; i < N; ++i) {
-        if (i % 2 == 0) {
-            code.push_back(std::make_unique<PrintInst>(
-                "Step " + std::to_string(i + 1) + " of " + name));
-            continue;
+                 std::shared_ptr<const Program> program, LogWriter* sink)
+    : name(std::move(name_)), id(id_), prog(std::move(program)), log_sink(sink)
+{}
+
+// One bytecode op per tick. Operands were resolved at compile time, so
+// this is a single switch with no string handling.
+bool Process::run_one_tick(TraceRecord* executed) {
+    if (done) return false;
+    if (!start_time[0]) std::strcpy(start_time, util::now_time_cstr());
+    if (sleep_ticks > 0) { --sleep_ticks; return false; }
+
+    const auto& code = prog->code;
+    bool ran = false;
+    if (pc < code.size()) {
+        ran = true;
+        ++ticks_run;
+        TraceRecord rec;
+        rec.pc = static_cast<uint32_t>(pc);
+        const Bytecode& bc = code[pc++];
+        auto arg = [this](uint16_t v, bool imm) { return imm ? int(v) : int(vars[v]); };
+
+        switch (bc.op) {
+        case Op::PRINT:
+            break;
+        case Op::DECL:
+            vars[bc.dst] = bc.a;
+            rec.arg0 = rec.result = bc.a;
+            break;
+        case Op::ADD:
+        case Op::SUB: {
+            int a = arg(bc.a, bc.flags & Bytecode::A_IMM);
+            int b = arg(bc.b, bc.flags & Bytecode::B_IMM);
+            int res = bc.op == Op::ADD ? a + b : a - b;
+            vars[bc.dst] = static_cast<uint16_t>(std::clamp(res, 0, 65535));
+            rec.arg0 = static_cast<uint32_t>(a);
+            rec.arg1 = static_cast<uint32_t>(b);
+            rec.result = vars[bc.dst];
+            break;
         }
-
-        int t = rng() % 4;
-
-        if (t == 0) {                                 
-            std::string v = "v" + std::to_string(var_count++);
-            int val       = rng() % 100;
-            var_names.push_back(v);
-            code.push_back(std::make_unique<DeclInst>(v, val));
-
-        } else if (t == 1 || t == 2) {                  
-            std::string dest = "v" + std::to_string(rng() % (var_count + 1));
-            std::string op1  = var_names.empty()
-                             ? "0" : var_names[rng() % var_names.size()];
-            std::string op2  = std::to_string(rng() % 50);
-            bool is_add      = (t == 1);
-            code.push_back(
-                std::make_unique<MathInst>(dest, op1, op2, is_add));
-
-        } else {                                        
-            int repeats = 1 + rng() % 2;               
-            int looplen = 1 + rng() % 2;                
-            std::vector<std::unique_ptr<Instruction>> body;
-            for (int j = 0; j < looplen; ++j)
-                body.push_back(
-                    std::make_unique<SleepInst>(delay > 0 ? delay : 1));
-            code.push_back(
-                std::make_unique<ForInst>(repeats, std::move(body)));
+        case Op::SLEEP:
+            sleep_ticks = static_cast<int>(bc.imm);
+            rec.arg0 = bc.imm;
+            break;
+        case Op::FOR:
+            rec.arg0 = bc.a;
+            if (bc.a == 0 || loop_depth == kMaxLoopDepth) pc = bc.imm;
+            else loop_remaining[loop_depth++] = bc.a;
+            break;
+        case Op::END:
+            if (loop_depth == 0) break;
+            if (--loop_remaining[loop_depth - 1] > 0) pc = bc.imm;
+            else --loop_depth;
+            break;
         }
+
+        rec.wall  = std::time(nullptr);
+        rec.cycle = cpu_cycles_counter.load(std::memory_order_relaxed);
+        rec.core  = static_cast<int16_t>(core_id.load());
+        rec.op    = bc.op;
+        log(rec);
+        if (executed) *executed = rec;
     }
 
-    bool has_print =
-        std::any_of(code.begin(), code.end(), [](const auto& up) {
-            return dynamic_cast<PrintInst*>(up.get()) != nullptr;
-        });
-    if (!has_print) {
-        code.insert(code.begin(),
-            std::make_unique<PrintInst>("Auto: Hello from " + name));
+    if (pc >= code.size()) {
+        done = true;
+        const std::time_t now = std::time(nullptr);
+        if (!finished_time[0]) std::strcpy(finished_time, util::format_time(now));
+        times.finish_tick = cpu_cycles_counter.load(std::memory_order_relaxed);
+        times.finish_ns   = util::steady_ns();
+        if (log_sink) {
+            TraceRecord fin;
+            fin.kind  = TraceRecord::FINISHED;
+            fin.wall  = now;
+            fin.cycle = cpu_cycles_counter.load(std::memory_order_relaxed);
+            fin.pc    = static_cast<uint32_t>(pc);
+            fin.core  = static_cast<int16_t>(core_id.load());
+            log_sink->append(core_id, name, log_seq++, fin);
+            log_sink->close(core_id, name, log_seq++);
+        }
     }
+    return ran;
 }
 
-void Process::run_one_tick() {
-    if (done) return;
-    if (start_time.empty()) start_time = util::now_time();
-    if (sleep_ticks > 0) { --sleep_ticks; return; }
-
-    if (pc < code.size()) {
-        const std::size_t this_pc = pc;         
-        auto& inst = code[pc++];
-        inst->execute(*this);                  
-
-        std::ostringstream line;                
-        line << '(' << util::now_time() << ") Core:" << core_id << ' ';
-        line << "PC=" << this_pc << ' ' << inst->tag();
+void Process::mark_arrival()
+{
+    std::strcpy(created_time, util::now_time_cstr());
+    times.arrival_tick = times.ready_tick = cpu_cycles_counter.load(std::memory_order_relaxed);
+    times.arrival_ns   = times.ready_ns   = util::steady_ns();
+}
 
-        log(line.str());                     
+void Process::mark_dispatch()
+{
+    const uint64_t tick = cpu_cycles_counter.load(std::memory_order_relaxed);
+    const int64_t  ns   = util::steady_ns();
+    times.wait_ticks += tick - times.ready_tick;
+    times.wait_ns    += ns - times.ready_ns;
+    if (times.dispatches++ == 0) {
+        times.first_dispatch_tick = tick;
+        times.first_dispatch_ns   = ns;
     }
+}
 
-    if (pc >= code.size()) {
-        done = true;
-        if (finished_time.empty()) finished_time = util::now_time();
-        if (!log_stream.is_open())
-            log_stream.open("logs/" + name + ".txt", std::ios::app);
-        log_stream << "FINISHED at " << finished_time << '\n';
-    }
+void Process::mark_preempted()
+{
+    ++times.preemptions;
+    mark_ready();
 }
 
+void Process::mark_ready()
+{
+    times.ready_tick = cpu_cycles_counter.load(std::memory_order_relaxed);
+    times.ready_ns   = util::steady_ns();
+}
 
-void Process::log(const std::string& msg)
+void Process::log(const TraceRecord& rec)
 {
-    if (!log_stream.is_open())
-        log_stream.open("logs/" + name + ".txt", std::ios::app);
-    log_stream << msg << '\n';
+    if (log_sink) log_sink->append(core_id, name, log_seq++, rec);
 
     std::lock_guard<std::mutex> lk(mtx);
-    logs.push_back(msg);
-    if (logs.size() > 50) logs.erase(logs.begin());
+    history.push(rec);
 }
 
-std::vector<std::string> Process::recent_logs(size_t n) const {
+Process::LogHistory::View Process::recent_logs(size_t n) const {
     std::lock_guard<std::mutex> lk(mtx);
-    if (logs.size() <= n) return logs;
-    return {logs.end() - n, logs.end()};
+    return history.recent(n);
 }
 
 void Process::print_smi_info() const
@@ -139,28 +168,19 @@ void Process::print_smi_info() const
     std::cout << "ID: " << id << "\n";
     std::cout << "Recent logs (max 5):\n";
 
-    std::lock_guard<std::mutex> lk(mtx);
-    for (const auto& line : logs)
-        std::cout << line << '\n';
+    for (const auto& rec : recent_logs(5))
+        std::cout << render_trace(rec) << '\n';
 
     std::cout << "\nCurrent instruction line: " << pc
-              << '/' << code.size() << '\n';
+              << '/' << prog->code.size() << '\n';
     if (done) std::cout << "\nFINISHED!\n";
 }
 
-void Process::set_var(const std::string &var, int val)
-{
-    if (val < 0) val = 0;
-    if (val > 65535) val = 65535;
-    vars[var] = val;
-}
-
-int Process::get_var_or_val(const std::string &s) const
+int Process::get_var(const std::string& var) const
 {
-    if (isdigit(s[0])) return std::stoi(s);
-    auto it = vars.find(s);
-    return it != vars.end() ? it->second : 0;
+    for (std::size_t i = 0; i < prog->symbols.size(); ++i)
+        if (prog->symbols[i] == var) return vars[i];
+    return 0;
 }
 
-void Process::sleep(int t)   { sleep_ticks = t; }
 bool Process::is_finished() const { return done; }
\ No newline at end of file
@@ -1,49 +1,100 @@
 #pragma once
-#include "instruction.h"
+#include "bytecode.h"
+#include "log_writer.h"
+#include "log_ring.h"
+#include "trace.h"
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <mutex>
-#include <map>
-#include <fstream>
 #include <atomic>
 
+// Monotonic scheduling timestamps. Ticks are cpu_cycles_counter readings,
+// ns are util::steady_ns(); both are zero until the event happens.
+struct SchedTimes {
+    uint64_t arrival_tick = 0, first_dispatch_tick = 0, finish_tick = 0;
+    int64_t  arrival_ns   = 0, first_dispatch_ns   = 0, finish_ns   = 0;
+    uint64_t ready_tick   = 0;  int64_t ready_ns = 0;   // last entered the ready queue
+    uint64_t wait_ticks   = 0;  int64_t wait_ns  = 0;   // total time ready, not running
+    uint32_t dispatches   = 0, preemptions = 0;
+
+    uint64_t response_ticks()   const { return first_dispatch_tick - arrival_tick; }
+    int64_t  response_ns()      const { return first_dispatch_ns - arrival_ns; }
+    uint64_t turnaround_ticks() const { return finish_tick - arrival_tick; }
+    int64_t  turnaround_ns()    const { return finish_ns - arrival_ns; }
+};
+
 class Process {
     std::string name;
     int id;
-    std::vector<std::unique_ptr<Instruction>> code;
+    std::shared_ptr<const Program> prog;    // shared, read-only
     size_t pc = 0;
     int sleep_ticks = 0;
-    std::map<std::string, int> vars;
-    std::vector<std::string> logs;
+    uint64_t ticks_run = 0;                 // instructions executed so far
+    std::array<uint16_t, kMaxVars + 1> vars{};   // indexed by Program slot
+    // repeats left per open FOR; END jumps back via its own imm
+    std::array<uint32_t, kMaxLoopDepth> loop_remaining{};
+    uint8_t loop_depth = 0;
+public:
+    // recent-log history kept in memory for process-smi / screen -ls
+    using LogHistory = LogRing<TraceRecord, 16>;
+private:
+    LogHistory history;                     // guarded by mtx
     mutable std::mutex mtx;
     bool done = false;
-    bool logs_saved = false;
-    std::string created_time;
-    std::string start_time;
-    std::string finished_time;
-    std::ofstream log_stream; 
+    // "YYYY-MM-DD HH:MM:SS" as util::format_time writes it; empty until set.
+    // Inline rather than std::string so admission does not allocate.
+    char created_time[20]  = {};
+    char start_time[20]    = {};
+    char finished_time[20] = {};
+    LogWriter* log_sink = nullptr;          // null: no on-disk log
+    uint64_t log_seq = 0;
     std::atomic<int> core_id{-1};
+    SchedTimes times;                       // written by whoever owns the process
+    // strong self-reference held while queued in a lock-free run queue
+    std::shared_ptr<Process> queue_pin;
+    friend class WorkStealingScheduler;
+    // MLFQ priority level and the boost epoch it was assigned in
+    uint8_t  sched_level = 0;
+    uint32_t sched_epoch = 0;
+    friend class MLFQScheduler;
 public:
     Process() = default;
-    Process(std::string name, int id, int min_ins, int max_ins, int delay);
-    void run_one_tick();
-    void log(const std::string& msg);
+    Process(std::string name, int id, std::shared_ptr<const Program> program,
+            LogWriter* sink = nullptr);
+    // returns true if an instruction executed (not sleeping/finished) and
+    // copies its trace record to *executed when given
+    bool run_one_tick(TraceRecord* executed = nullptr);
+    void log(const TraceRecord& rec);
     void print_smi_info() const;
-    void set_var(const std::string& var, int val);
-    int get_var_or_val(const std::string& s) const;
-    void sleep(int t);
     bool is_finished() const;
     int get_id() const { return id; }
     std::string get_name() const { return name; }
     size_t get_pc() const { return pc; }
-    size_t get_code_size() const { return code.size(); }
+    size_t get_code_size() const { return prog->code.size(); }
     int get_core_id() const { return core_id; }
-    const std::vector<std::string>& get_logs() const { return logs; }
     std::string get_created_time() const { return created_time; }
     std::string get_start_time() const { return start_time; }
     std::string get_finished_time() const { return finished_time; }
-    size_t code_size()    const { return code.size(); }
-    std::vector<std::string> recent_logs(size_t n) const;
+    size_t code_size()    const { return prog->code.size(); }
+    // instructions left until completion; exact, since Program::ticks is
+    uint64_t remaining_ticks() const { return prog->ticks > ticks_run ? prog->ticks - ticks_run : 0; }
+    int get_var(const std::string& var) const;
+    LogHistory::View recent_logs(size_t n) const;
     void set_core_id(int id) { core_id = id; }
+
+    // scheduling events; each is called by the thread that currently owns
+    // the process (the creator before publishing, then its worker)
+    void mark_arrival();
+    void mark_dispatch();
+    void mark_preempted();
+    void mark_ready();                      // back in the ready queue, e.g. after a sleep
+    // ticks the last SLEEP asked for; zeroes them, so the caller takes over
+    // the wait (the process is parked instead of sleeping on a core)
+    int take_sleep() { int n = sleep_ticks; sleep_ticks = 0; return n; }
+    // a trailing SLEEP finishes the process; there is nothing left to wait for
+    bool is_sleeping() const { return !done && sleep_ticks > 0; }
+    const SchedTimes& sched_times() const { return times; }
 };
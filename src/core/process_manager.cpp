@@ -7,19 +7,12 @@
 #include <fstream>
 #include <algorithm>
 #include <filesystem>
+#include <random>
 #include <bits/basic_string.h>
 
-extern std::atomic<uint64_t> cpu_cycles_counter;
-
-
-static std::string format_percent(double v) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << v;
-    return oss.str();
-}
 
 ProcessManager::ProcessManager(uint32_t cores)
-    : util(cores) {}
+    : util(cores), events(cores) {}
 
 ProcessManager::~ProcessManager()
 {
@@ -33,104 +26,254 @@ void ProcessManager::initialize_scheduler(const std::string &alg, uint64_t quant
 {
     if (alg == "fcfs") {
         sched = std::make_unique<FCFSScheduler>();
-        scheduler_is_rr_ = false;
+    } else if (alg == "ws") {
+        sched = std::make_unique<WorkStealingScheduler>(util.get_total_cores(), quantum);
+    } else if (alg == "sjf" || alg == "srtf") {
+        sched = std::make_unique<ShortestJobScheduler>(alg == "srtf");
+    } else if (alg == "mlfq") {
+        // default quanta double per level, starting at quantum-cycles
+        std::vector<uint64_t> quanta;
+        std::string list = cfg ? cfg->get_or("mlfq-quanta", "") : "";
+        for (std::size_t pos = 0; pos < list.size();) {
+            auto comma = list.find(',', pos);
+            if (comma == std::string::npos) comma = list.size();
+            quanta.push_back(std::stoull(list.substr(pos, comma - pos)));
+            pos = comma + 1;
+        }
+        if (quanta.empty()) {
+            const uint64_t n = cfg ? cfg->get_long("mlfq-levels", 3) : 3;
+            for (uint64_t l = 0; l < n; ++l) quanta.push_back(quantum << l);
+        }
+        const uint64_t boost = cfg ? cfg->get_long("mlfq-boost", 1000) : 1000;
+        sched = std::make_unique<MLFQScheduler>(std::move(quanta), boost);
     } else {
         sched = std::make_unique<RRScheduler>(quantum);
-        scheduler_is_rr_   = true;
-        rr_quantum_cycles_ = quantum;
     }
 }
 
 void ProcessManager::start_scheduler()
 {
+    if (!sched) return;
     running = true;
-    const auto cores = util.get_total_cores();
+    const auto cores = static_cast<uint32_t>(util.get_total_cores());
+    if (cfg) {
+        tick_duration_ms_ = cfg->get_long("tick-duration", tick_duration_ms_);
+        programs = std::make_unique<ProgramCache>(
+            cfg->get_long("program-pool", 64),
+            static_cast<int>(cfg->get_long("min-ins")),
+            static_cast<int>(cfg->get_long("max-ins")),
+            static_cast<int>(cfg->get_long("delays-per-exec")),
+            static_cast<uint32_t>(cfg->get_long("seed", std::random_device{}())));
+        log_writer = std::make_unique<LogWriter>(cores, cfg->get_long("log-open-files", 64));
+    }
+    sampler = std::make_unique<UtilizationSampler>(util, [this] { return sched->queued(); });
 
     for (uint32_t core = 0; core < cores; ++core) {
         workers_.emplace_back([this, core]() {
             while (running) {
-                std::shared_ptr<Process> p;
-                {                               
-                    std::lock_guard<std::mutex> lk(procs_mutex);
-                    if (sched && sched->has_processes())
-                        p = sched->next_process();
-                }
-
+                auto p = sched->next_for_core(core);
                 if (!p) {
-                    util.mark_idle(core);                    
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                    continue;
+                    util.mark_idle(core);
+                    kick_clock();                     // may be the last busy core
+                    p = sched->wait_for_core(core);   // nullptr on shutdown
+                    if (!p) break;
                 }
 
                 util.mark_busy(core);                 
                 p->set_core_id(core);
+                p->mark_dispatch();
 
-                const uint64_t q = scheduler_is_rr_ ? rr_quantum_cycles_ : 1;
+                const uint64_t q = sched->quantum_for(*p);
                 for (uint64_t i = 0; i < q && !p->is_finished(); ++i) {
-                    p->run_one_tick();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                    TraceRecord rec;
+                    if (p->run_one_tick(&rec))
+                        events.record(static_cast<int>(core), rec);
+                    util.add_ticks(core, 1);
+                    cpu_cycles_counter.fetch_add(1, std::memory_order_relaxed);
+                    pace_tick();
+                    if (cpu_cycles_counter.load(std::memory_order_relaxed) >=
+                        next_wake.load(std::memory_order_relaxed))
+                        wake_sleepers();
+                    if (p->is_sleeping()) break;
+                    if (!p->is_finished() && sched->should_preempt(*p)) break;
                 }
 
-                if (!p->is_finished()) {
-                    std::lock_guard<std::mutex> lk(procs_mutex);
-                    sched->add_process(p);
+                if (p->is_sleeping()) {
+                    p->set_core_id(-1);
+                    park(std::move(p));
+                } else if (!p->is_finished()) {
+                    p->mark_preempted();
+                    sched->requeue_from_core(core, std::move(p));
                 } else {
-                    p->set_core_id(-1);          
+                    p->set_core_id(-1);
+                    record_completion(*p);
+                    registry.archive(p);
                 }
             }
         });
     }
+    clock_thread = std::thread([this] { drive_clock(); });
+}
+
+// A SLEEP of n ticks parks the process on the timer wheel until the cycle
+// counter has moved n ticks on, leaving its core free for runnable work.
+void ProcessManager::park(std::shared_ptr<Process> p)
+{
+    const uint64_t ticks = static_cast<uint64_t>(p->take_sleep());
+    std::lock_guard<std::mutex> lk(sleep_mtx);
+    sleepers.schedule(cpu_cycles_counter.load(std::memory_order_relaxed) + ticks, std::move(p));
+    next_wake.store(sleepers.next_due(), std::memory_order_relaxed);
+}
+
+void ProcessManager::wake_sleepers()
+{
+    std::vector<std::shared_ptr<Process>> due;
+    {
+        std::lock_guard<std::mutex> lk(sleep_mtx);
+        sleepers.advance(cpu_cycles_counter.load(std::memory_order_relaxed), due);
+        next_wake.store(sleepers.next_due(), std::memory_order_relaxed);
+    }
+    for (auto& p : due) {
+        p->mark_ready();
+        sched->add_process(std::move(p));
+    }
 }
 
+// Workers advance the cycle counter as they run. When every core is idle and
+// nothing is queued, nothing would move the clock to the next wake-up or
+// batch arrival, so this thread does: one tick per tick-duration when paced,
+// otherwise a jump straight to the next event.
+void ProcessManager::kick_clock()
+{
+    { std::lock_guard<std::mutex> lk(clock_mtx); clock_kick = true; }
+    clock_cv.notify_one();
+}
+
+void ProcessManager::drive_clock()
+{
+    const auto period = std::chrono::milliseconds(tick_duration_ms_ > 0 ? tick_duration_ms_ : 1);
+    std::unique_lock<std::mutex> lk(clock_mtx);
+    while (running) {
+        clock_cv.wait_for(lk, period, [this] { return clock_kick || !running; });
+        clock_kick = false;
+        if (!running) break;
+        const uint64_t wake   = next_wake.load(std::memory_order_relaxed);
+        const uint64_t arrive = next_arrival.load(std::memory_order_relaxed);
+        const uint64_t due    = std::min(wake, arrive);
+        if (due == UINT64_MAX) continue;
+        if (util.get_busy_cores() == 0 && !sched->has_processes()) {
+            uint64_t now = cpu_cycles_counter.load(std::memory_order_relaxed);
+            const uint64_t target = tick_duration_ms_ > 0 ? now + 1 : std::max(now, due);
+            while (now < target &&
+                   !cpu_cycles_counter.compare_exchange_weak(now, target, std::memory_order_relaxed)) {}
+        }
+        const uint64_t now = cpu_cycles_counter.load(std::memory_order_relaxed);
+        if (now >= wake) wake_sleepers();
+        if (now >= arrive) {
+            { std::lock_guard<std::mutex> blk(batch_mtx); batch_kick = true; }
+            batch_cv.notify_one();
+        }
+    }
+}
+
+void ProcessManager::record_completion(const Process& p)
+{
+    const SchedTimes& t = p.sched_times();
+    wait_stats.ticks.record(t.wait_ticks);
+    wait_stats.ns.record(static_cast<uint64_t>(std::max<int64_t>(0, t.wait_ns)));
+    response_stats.ticks.record(t.response_ticks());
+    response_stats.ns.record(static_cast<uint64_t>(std::max<int64_t>(0, t.response_ns())));
+    turnaround_stats.ticks.record(t.turnaround_ticks());
+    turnaround_stats.ns.record(static_cast<uint64_t>(std::max<int64_t>(0, t.turnaround_ns())));
+}
+
+void ProcessManager::pace_tick() const
+{
+    // tick-duration 0 runs the emulation unpaced
+    if (tick_duration_ms_ > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(tick_duration_ms_));
+}
 
 void ProcessManager::stop_scheduler()
 {
     running = false;
+    if (sched) sched->shutdown();
+    kick_clock();
+    if (clock_thread.joinable()) clock_thread.join();
     for (auto& t : workers_)
         if (t.joinable()) t.join();
     workers_.clear();
+    sampler.reset();
 }
 
+// One process arrives every batch-process-freq cycles of cpu_cycles_counter,
+// starting now. Each pass admits every arrival that has come due: the
+// processes are built off-lock, then published with one registry call and
+// one scheduler call, so a high arrival rate costs a few lock round-trips
+// per batch rather than per process.
 void ProcessManager::start_batch_processing()
 {
-    if (!cfg)
+    if (!cfg || !programs || batching)
         return;
     batching = true;
-    uint64_t freq = cfg->get_long("batch-process-freq");
-    uint64_t delay = cfg->get_long("delays-per-exec");
-    uint64_t min_ins = cfg->get_long("min-ins");
-    uint64_t max_ins = cfg->get_long("max-ins");
-
-    batch_thread = std::thread([this, freq, delay, min_ins, max_ins]()
-                               {
-        while (batching) {
-            if ((cpu_cycles_counter % freq) == 0) {
-                std::string name = "p" + std::to_string(next_id);
-                auto p = std::make_shared<Process>(name, next_id++, min_ins, max_ins, delay);
-                {
-                    std::lock_guard<std::mutex> lk(procs_mutex);
-                    procs.push_back(p);
-                    if (sched) sched->add_process(p);
-                }
+    const uint64_t freq = cfg->get_long("batch-process-freq");
+    next_arrival.store(cpu_cycles_counter.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    batch_thread = std::thread([this, freq] { run_arrivals(freq); });
+}
+
+void ProcessManager::run_arrivals(uint64_t freq)
+{
+    constexpr uint64_t kMaxBatch = 1024;        // bounds one publish
+    const auto period = std::chrono::milliseconds(tick_duration_ms_ > 0 ? tick_duration_ms_ : 1);
+    std::vector<std::shared_ptr<Process>> batch;
+
+    while (batching) {
+        const uint64_t now = cpu_cycles_counter.load(std::memory_order_relaxed);
+        const uint64_t due = next_arrival.load(std::memory_order_relaxed);
+        if (now >= due) {
+            const uint64_t k = std::min((now - due) / freq + 1, kMaxBatch);
+            const uint64_t first = next_id.fetch_add(k);
+            batch.reserve(k);
+            for (uint64_t i = 0; i < k; ++i) {
+                auto p = make_pooled<Process>("p" + std::to_string(first + i),
+                                             static_cast<int>(first + i),
+                                             programs->pick(), log_writer.get());
+                p->mark_arrival();
+                batch.push_back(std::move(p));
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
-        } });
+            registry.insert_batch(batch);       // drops names taken by screen -s
+            if (sched) sched->add_batch(batch);
+            batch.clear();
+            next_arrival.store(due + k * freq, std::memory_order_relaxed);
+            if (k == kMaxBatch) continue;       // still behind the clock
+        }
+        std::unique_lock<std::mutex> lk(batch_mtx);
+        batch_cv.wait_for(lk, period, [this] { return batch_kick || !batching; });
+        batch_kick = false;
+    }
 }
 
 void ProcessManager::stop_batch_processing()
 {
-    batching = false;
+    {
+        std::lock_guard<std::mutex> lk(batch_mtx);
+        batching = false;
+    }
+    batch_cv.notify_all();
     if (batch_thread.joinable())
         batch_thread.join();
+    next_arrival.store(UINT64_MAX, std::memory_order_relaxed);
 }
 
 std::shared_ptr<Process> ProcessManager::get_process(const std::string &name) const
 {
-    std::lock_guard<std::mutex> lk(procs_mutex);
-    for (auto &p : procs)
-        if (p->get_name() == name)
-            return p;
-    return nullptr;
+    return registry.find(name);
+}
+
+std::optional<FinishedProcess> ProcessManager::get_finished_process(const std::string &name) const
+{
+    return registry.find_finished(name);
 }
 
 void ProcessManager::add_process(const std::string &name)
@@ -143,111 +286,159 @@ std::shared_ptr<Process> ProcessManager::get_or_create_process(const std::string
     auto p = get_process(name);
     if (p)
         return p;
-    if (!cfg)
+    if (!programs || registry.find_finished(name))
         return nullptr;
-    uint32_t delay = cfg->get_long("delays-per-exec");
-    uint32_t min_ins = cfg->get_long("min-ins");
-    uint32_t max_ins = cfg->get_long("max-ins");
-    p = std::make_shared<Process>(name, next_id++, min_ins, max_ins, delay);
-    {
-        std::lock_guard<std::mutex> lk(procs_mutex);
-        procs.push_back(p);
-        if (sched)
-            sched->add_process(p);
-    }
-    return p;
+    return admit(make_pooled<Process>(name, static_cast<int>(next_id++),
+                                      programs->pick(), log_writer.get()));
+}
+
+std::shared_ptr<Process> ProcessManager::submit(const std::string &name,
+                                                std::shared_ptr<const Program> program)
+{
+    return admit(make_pooled<Process>(name, static_cast<int>(next_id++),
+                                      std::move(program), log_writer.get()));
+}
+
+// Registers a new process and queues it. If the name is already taken
+// (e.g. screen -s raced the batch thread) the existing process is returned
+// and the new one is dropped.
+std::shared_ptr<Process> ProcessManager::admit(std::shared_ptr<Process> p)
+{
+    p->mark_arrival();
+    auto registered = registry.insert(p);
+    if (registered == p && sched)
+        sched->add_process(p);
+    return registered;
+}
+
+bool ProcessManager::wait_for_finished(std::size_t n, std::chrono::milliseconds timeout) const
+{
+    return registry.wait_finished(n, std::chrono::steady_clock::now() + timeout);
 }
 
 void ProcessManager::print_system_status(std::ostream& out) const
 {
-    const auto total = util.get_total_cores();
-    const auto busy  = util.get_busy_cores();
+    const auto s = util.sample();
 
     out << "CPU utilization : "
         << std::fixed << std::setprecision(1)
-        << util.get_utilization_percent() << " %\n"
-        << "Cores used      : " << busy  << '/' << total << '\n'
-        << "Cores available : " << (total - busy) << "\n\n";
+        << s.instant_percent << " %\n"
+        << "Avg utilization : " << s.weighted_percent << " % since start\n"
+        << "Cores used      : " << s.busy_cores  << '/' << s.total_cores << '\n'
+        << "Cores available : " << (s.total_cores - s.busy_cores) << "\n\n";
 }
 
 void ProcessManager::print_recent_logs(std::ostream& out,
                                        std::size_t max_lines) const
 {
-    std::vector<std::string> all;
-    {
-        std::lock_guard<std::mutex> lk(procs_mutex);
-        for (const auto& p : procs) {
-            const auto& v = p->recent_logs(max_lines);   
-            all.insert(all.end(), v.begin(), v.end());   
-        }
-    }  
+    out << "\nRecent logs (newest first, max " << max_lines << "):\n";
+    for (const auto& rec : events.newest(max_lines))
+        out << "  " << render_trace(rec) << '\n';
+}
 
-    if (all.size() > max_lines)
-        all.erase(all.begin(), all.end() - max_lines);
+bool ProcessManager::print_process_smi(const std::string& name, std::ostream& out) const
+{
+    // a process that finished meanwhile has left for the archive, which
+    // keeps its id and size but not its logs
+    auto p = registry.find(name);
+    std::optional<FinishedProcess> done;
+    if (!p && !(done = registry.find_finished(name))) return false;
+
+    const std::size_t size = p ? p->get_code_size() : done->code_size;
+    out << "===== Process Name: " << name << " =====\n";
+    out << "ID: " << (p ? p->get_id() : done->id) << '\n';
+    out << "Logs:\n";
+    if (p)
+        for (const auto& rec : p->recent_logs(5)) out << render_trace(rec) << '\n';
+    out << "\nCurrent instruction line: " << (p ? p->get_pc() : size) << '/' << size << '\n';
+    if (!p || p->is_finished()) out << "\nFINISHED!\n";
+    return true;
+}
 
-    out << "\nRecent logs (newest first, max " << max_lines << "):\n";
-    for (auto it = all.rbegin(); it != all.rend(); ++it)
-        out << "  " << *it << '\n';
+void ProcessManager::print_utilization_trend(std::ostream& out) const
+{
+    if (sampler) sampler->print_report(out);
+}
+
+// Wait = time spent ready but not on a core; response = arrival to first
+// dispatch; turnaround = arrival to completion. Ticks are global cycles.
+void ProcessManager::print_latency_stats(std::ostream& out) const
+{
+    out << "Scheduling latency (" << turnaround_stats.ticks.count() << " finished):\n"
+        << "  metric        unit       mean       p50       p90       p99       max\n"
+        << std::fixed << std::setprecision(1);
+    auto row = [&out](const char* name, const char* unit, const LatencyHistogram& h, double scale) {
+        out << "  " << std::left << std::setw(13) << name << ' ' << std::setw(6) << unit << std::right
+            << std::setw(10) << h.mean() / scale
+            << std::setw(10) << h.percentile(50) / scale
+            << std::setw(10) << h.percentile(90) / scale
+            << std::setw(10) << h.percentile(99) / scale
+            << std::setw(10) << h.max() / scale << '\n';
+    };
+    for (auto [name, stats] : { std::pair{"wait", &wait_stats},
+                                std::pair{"response", &response_stats},
+                                std::pair{"turnaround", &turnaround_stats} }) {
+        row(name, "ticks", stats->ticks, 1.0);
+        row(name, "ms",    stats->ns,    1e6);
+    }
+    out << '\n';
 }
 
 void ProcessManager::print_process_lists(std::ostream& out,
                                          bool full) const
 {
 
-    std::vector<std::shared_ptr<Process>> running, finished;
-    {
-        std::lock_guard<std::mutex> lk(procs_mutex);
-        running.reserve(procs.size());
-        finished.reserve(procs.size());
-        for (auto const& p : procs)
-            (p->is_finished() ? finished : running).push_back(p);
-    } 
-
-    auto dump = [&](auto const& vec, std::string_view title)
-    {
-        out << title << '\n';
-        std::size_t shown = 0;
-        const bool isRunning = title.compare(0, 7, "Running") == 0;
-
-        for (auto const& p : vec) {
-            if (!full && shown == 5) { out << "…\n"; break; }
-
-            if (isRunning) {
-                out << std::left << std::setw(15) << p->get_name() << ' '
-                    << util::now_time() << "  Core:" << p->get_core_id() << "  "
-                    << p->get_pc() << '/' << p->get_code_size() << '\n';
-            } else {
-                out << std::left << std::setw(15) << p->get_name() << ' '
-                    << p->get_finished_time() << "  FINISHED  "
-                    << p->get_code_size() << '/' << p->get_code_size() << '\n';
-            }
-            ++shown;
-        }
-        out << '\n';
-    };
-
+    // one row past the limit tells us whether to print the ellipsis
+    const std::size_t limit = full ? SIZE_MAX : 5;
+    const std::size_t fetch = full ? SIZE_MAX : limit + 1;
+    const auto running  = registry.live_head(fetch);
+    const auto finished = registry.finished_head(fetch);
+
+    const std::string now = util::now_time();
+
+    out << "Running processes:\n";
+    std::size_t shown = 0;
+    for (auto const& p : running) {
+        if (shown++ == limit) { out << "…\n"; break; }
+        out << std::left << std::setw(15) << p->get_name() << ' '
+            << now << "  Core:" << p->get_core_id() << "  "
+            << p->get_pc() << '/' << p->get_code_size() << '\n';
+    }
+    out << '\n';
+
+    out << "Finished processes:\n";
+    shown = 0;
+    for (auto const& f : finished) {
+        if (shown++ == limit) { out << "…\n"; break; }
+        out << std::left << std::setw(15) << f.name << ' '
+            << f.finished_time << "  FINISHED  "
+            << f.code_size << '/' << f.code_size << '\n';
+    }
+    out << '\n';
 
-    dump(running , "Running processes:");
-    dump(finished, "Finished processes:");
     out << "___________________________________________________________\n";
 }
 
 void ProcessManager::generate_utilization_report() const
 {
     std::ofstream ofs("csopesy-log.txt", std::ios::app);
-    ofs << "CPU utilization: " << std::fixed << std::setprecision(1)
-    << util.get_utilization_percent() << "%\n"
-    << "Cores used: "      << util.get_busy_cores()      << '\n'
-    << "Cores available: " << util.get_available_cores() << "\n\n";
+    util.print_report(ofs);
+    ofs << '\n';
 }
 
 void ProcessManager::shutdown()
 {
     running = false;
+    batching = false;
+    batch_cv.notify_all();
+    if (sched) sched->shutdown();
+    kick_clock();
+    if (clock_thread.joinable()) clock_thread.join();
 
     for (auto& t : workers_)
         if (t.joinable()) t.join();
     workers_.clear();
+    sampler.reset();
 
     if (batch_thread.joinable())
         batch_thread.join();
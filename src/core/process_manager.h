@@ -1,13 +1,24 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <optional>
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include "config_manager.h"
 #include "cpu_utilization.h"
 #include "scheduler.h"
 #include "process.h"
+#include "program_cache.h"
+#include "log_writer.h"
+#include "process_registry.h"
+#include "recent_events.h"
+#include "utilization_sampler.h"
+#include "latency_histogram.h"
+#include "timer_wheel.h"
 
 class ProcessManager {
 public:
@@ -24,8 +35,25 @@ public:
     void stop_batch_processing();
 
     std::shared_ptr<Process> get_process(const std::string &name) const;
+    // set once the named process has finished and left the live index
+    std::optional<FinishedProcess> get_finished_process(const std::string &name) const;
     void add_process(const std::string &name);
     std::shared_ptr<Process> get_or_create_process(const std::string &name);
+    // queues a process running a caller-supplied program
+    std::shared_ptr<Process> submit(const std::string &name, std::shared_ptr<const Program> program);
+    // blocks until n processes have finished; false on timeout
+    bool wait_for_finished(std::size_t n, std::chrono::milliseconds timeout) const;
+    void set_tick_duration(uint64_t ms) { tick_duration_ms_ = ms; }
+    bool is_batching() const { return batching; }
+    // no live process and no arrivals, so nothing advances cpu_cycles_counter
+    bool is_idle() const { return !batching && registry.live_count() == 0; }
+
+    // completion histograms, in ticks of cpu_cycles_counter
+    const LatencyHistogram& wait_ticks()       const { return wait_stats.ticks; }
+    const LatencyHistogram& response_ticks()   const { return response_stats.ticks; }
+    const LatencyHistogram& turnaround_ticks() const { return turnaround_stats.ticks; }
+    const LatencyHistogram& turnaround_ns()    const { return turnaround_stats.ns; }
+    UtilizationSample utilization() const { return util.sample(); }
 
     void print_system_status(std::ostream& out) const;
     void print_process_lists(std::ostream&) const; 
@@ -34,17 +62,50 @@ public:
 
     void print_process_lists(std::ostream& out, bool full = true) const;
     void print_recent_logs(std::ostream& out, std::size_t max_lines) const;
+    // process-smi for a live or archived process; false if neither
+    bool print_process_smi(const std::string& name, std::ostream& out) const;
+    void print_utilization_trend(std::ostream& out) const;
+    void print_latency_stats(std::ostream& out) const;
 private:
-    mutable std::mutex procs_mutex;
-    std::vector<std::shared_ptr<Process>> procs;
+    void pace_tick() const;
+    void record_completion(const Process& p);
+    std::shared_ptr<Process> admit(std::shared_ptr<Process> p);
+    void park(std::shared_ptr<Process> p);
+    void wake_sleepers();
+    void drive_clock();
+    void kick_clock();
+    void run_arrivals(uint64_t freq);
+
+    // one metric in both clock domains
+    struct LatencyStats { LatencyHistogram ticks, ns; };
+
+    // synchronized independently of the ready queue, which sched owns
+    ProcessRegistry registry;
     std::unique_ptr<SchedulerBase> sched;
-    uint64_t rr_quantum_cycles_ = 1;
-    bool scheduler_is_rr_   = false;
+    uint64_t tick_duration_ms_ = 30;
     ConfigManager* cfg = nullptr;
+    std::unique_ptr<ProgramCache> programs;
+    std::unique_ptr<LogWriter> log_writer;
     CPUUtilization util;
+    std::unique_ptr<UtilizationSampler> sampler;   // runs while the scheduler does
+    RecentEvents events;
+    LatencyStats wait_stats, response_stats, turnaround_stats;
     std::atomic<bool> running = false;
     std::atomic<bool> batching = false;
     std::thread batch_thread;
+    std::mutex batch_mtx;
+    std::condition_variable batch_cv;
+    std::atomic<uint64_t> next_arrival{UINT64_MAX};  // cycle of the next batch arrival
+    bool batch_kick = false;                          // guarded by batch_mtx
     std::atomic<uint64_t> next_id = 1;
     std::vector<std::thread> workers_;
+
+    // sleeping processes, off the ready queue until their wake-up tick
+    std::mutex sleep_mtx;
+    TimerWheel<std::shared_ptr<Process>> sleepers;
+    std::atomic<uint64_t> next_wake{UINT64_MAX};   // sleepers.next_due(), lock-free
+    std::thread clock_thread;
+    std::mutex clock_mtx;
+    std::condition_variable clock_cv;
+    bool clock_kick = false;                          // guarded by clock_mtx
 };
\ No newline at end of file
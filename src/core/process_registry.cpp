@@ -0,0 +1,165 @@
+#include "process_registry.h"
+#include <algorithm>
+#include <functional>
+
+ProcessRegistry::ProcessRegistry(std::size_t shards)
+    : by_name(shards ? shards : 1), by_id(shards ? shards : 1)
+{}
+
+ProcessRegistry::NameShard& ProcessRegistry::shard(const std::string& name)
+{
+    return by_name[std::hash<std::string>{}(name) % by_name.size()];
+}
+const ProcessRegistry::NameShard& ProcessRegistry::shard(const std::string& name) const
+{
+    return by_name[std::hash<std::string>{}(name) % by_name.size()];
+}
+ProcessRegistry::IdShard& ProcessRegistry::shard(int id)
+{
+    return by_id[static_cast<std::size_t>(id) % by_id.size()];
+}
+const ProcessRegistry::IdShard& ProcessRegistry::shard(int id) const
+{
+    return by_id[static_cast<std::size_t>(id) % by_id.size()];
+}
+
+std::shared_ptr<Process> ProcessRegistry::insert(std::shared_ptr<Process> p)
+{
+    const std::string name = p->get_name();
+    {
+        auto& s = shard(name);
+        std::unique_lock<std::shared_mutex> lk(s.mtx);
+        auto [it, added] = s.procs.emplace(name, p);
+        if (!added) return it->second;
+    }
+    {
+        auto& s = shard(p->get_id());
+        std::unique_lock<std::shared_mutex> lk(s.mtx);
+        s.procs[p->get_id()] = p;
+    }
+    std::unique_lock<std::shared_mutex> lk(running_mtx);
+    running.emplace(p->get_id(), p);
+    return p;
+}
+
+// Visits the batch shard by shard, so each shard lock is taken once no
+// matter how many of the batch land in it.
+void ProcessRegistry::insert_batch(std::vector<std::shared_ptr<Process>>& batch)
+{
+    std::vector<std::pair<NameShard*, std::size_t>> by_shard;
+    by_shard.reserve(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        by_shard.emplace_back(&shard(batch[i]->get_name()), i);
+    std::sort(by_shard.begin(), by_shard.end());
+    for (std::size_t i = 0; i < by_shard.size();) {
+        NameShard* s = by_shard[i].first;
+        std::unique_lock<std::shared_mutex> lk(s->mtx);
+        for (; i < by_shard.size() && by_shard[i].first == s; ++i) {
+            auto& p = batch[by_shard[i].second];
+            if (!s->procs.emplace(p->get_name(), p).second) p.reset();   // name taken
+        }
+    }
+    batch.erase(std::remove(batch.begin(), batch.end(), nullptr), batch.end());
+
+    std::vector<std::pair<IdShard*, std::size_t>> by_ids;
+    by_ids.reserve(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        by_ids.emplace_back(&shard(batch[i]->get_id()), i);
+    std::sort(by_ids.begin(), by_ids.end());
+    for (std::size_t i = 0; i < by_ids.size();) {
+        IdShard* s = by_ids[i].first;
+        std::unique_lock<std::shared_mutex> lk(s->mtx);
+        for (; i < by_ids.size() && by_ids[i].first == s; ++i) {
+            const auto& p = batch[by_ids[i].second];
+            s->procs[p->get_id()] = p;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lk(running_mtx);
+    for (const auto& p : batch)
+        running.emplace_hint(running.end(), p->get_id(), p);   // ids ascend
+}
+
+std::shared_ptr<Process> ProcessRegistry::find(const std::string& name) const
+{
+    auto& s = shard(name);
+    std::shared_lock<std::shared_mutex> lk(s.mtx);
+    auto it = s.procs.find(name);
+    return it == s.procs.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<Process> ProcessRegistry::find(int id) const
+{
+    auto& s = shard(id);
+    std::shared_lock<std::shared_mutex> lk(s.mtx);
+    auto it = s.procs.find(id);
+    return it == s.procs.end() ? nullptr : it->second;
+}
+
+std::optional<FinishedProcess> ProcessRegistry::find_finished(const std::string& name) const
+{
+    std::shared_lock<std::shared_mutex> lk(archive_mtx);
+    auto it = finished_by_name.find(name);
+    if (it == finished_by_name.end()) return std::nullopt;
+    return finished[it->second];
+}
+
+void ProcessRegistry::archive(const std::shared_ptr<Process>& p)
+{
+    {
+        std::unique_lock<std::shared_mutex> lk(archive_mtx);
+        finished_by_name[p->get_name()] = finished.size();
+        finished.push_back({p->get_name(), p->get_id(),
+                            p->get_finished_time(), p->get_code_size()});
+    }
+    {
+        auto& s = shard(p->get_name());
+        std::unique_lock<std::shared_mutex> lk(s.mtx);
+        s.procs.erase(p->get_name());
+    }
+    {
+        auto& s = shard(p->get_id());
+        std::unique_lock<std::shared_mutex> lk(s.mtx);
+        s.procs.erase(p->get_id());
+    }
+    {
+        std::unique_lock<std::shared_mutex> lk(running_mtx);
+        running.erase(p->get_id());
+    }
+    finished_cv.notify_all();
+}
+
+std::size_t ProcessRegistry::live_count() const
+{
+    std::shared_lock<std::shared_mutex> lk(running_mtx);
+    return running.size();
+}
+
+std::size_t ProcessRegistry::finished_count() const
+{
+    std::shared_lock<std::shared_mutex> lk(archive_mtx);
+    return finished.size();
+}
+
+bool ProcessRegistry::wait_finished(std::size_t n,
+                                    std::chrono::steady_clock::time_point deadline) const
+{
+    std::unique_lock<std::shared_mutex> lk(archive_mtx);
+    return finished_cv.wait_until(lk, deadline, [&] { return finished.size() >= n; });
+}
+
+std::vector<std::shared_ptr<Process>> ProcessRegistry::live_head(std::size_t n) const
+{
+    std::vector<std::shared_ptr<Process>> out;
+    std::shared_lock<std::shared_mutex> lk(running_mtx);
+    for (auto it = running.begin(); it != running.end() && out.size() < n; ++it)
+        out.push_back(it->second);
+    return out;
+}
+
+std::vector<FinishedProcess> ProcessRegistry::finished_head(std::size_t n) const
+{
+    std::shared_lock<std::shared_mutex> lk(archive_mtx);
+    const auto k = std::min(n, finished.size());
+    return {finished.begin(), finished.begin() + static_cast<std::ptrdiff_t>(k)};
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "object_pool.h"
+#include "process.h"
+
+// What is kept of a process once it has finished and left the live index.
+struct FinishedProcess {
+    std::string name;
+    int         id = 0;
+    std::string finished_time;
+    std::size_t code_size = 0;
+};
+
+// Live processes indexed by name and by id across independently locked
+// shards, plus an append-only archive of finished ones. Lookups hash to a
+// single shard. An id-ordered running list and the archive are updated on
+// admission and retirement, so listing the first k of either costs O(k).
+class ProcessRegistry {
+public:
+    explicit ProcessRegistry(std::size_t shards = 64);
+
+    // registers p unless its name is taken; returns whichever is registered
+    std::shared_ptr<Process> insert(std::shared_ptr<Process> p);
+    // registers a batch taking each shard lock once; processes whose name
+    // is taken are removed from `batch`, which then holds what was added
+    void insert_batch(std::vector<std::shared_ptr<Process>>& batch);
+    std::shared_ptr<Process> find(const std::string& name) const;
+    std::shared_ptr<Process> find(int id) const;
+    std::optional<FinishedProcess> find_finished(const std::string& name) const;
+
+    // moves a finished process from the live index into the archive
+    void archive(const std::shared_ptr<Process>& p);
+
+    std::size_t live_count() const;
+    std::size_t finished_count() const;
+    // blocks until at least n processes have been archived; false if the
+    // deadline passes first
+    bool wait_finished(std::size_t n, std::chrono::steady_clock::time_point deadline) const;
+
+    // first n live processes by id
+    std::vector<std::shared_ptr<Process>> live_head(std::size_t n = SIZE_MAX) const;
+    // first n finished processes in completion order
+    std::vector<FinishedProcess> finished_head(std::size_t n = SIZE_MAX) const;
+
+private:
+    // index nodes come from PoolArena, so they are recycled on archive
+    template <typename K, typename V>
+    using PooledMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>,
+                                         PoolAllocator<std::pair<const K, V>>>;
+
+    struct alignas(64) NameShard {
+        mutable std::shared_mutex mtx;
+        PooledMap<std::string, std::shared_ptr<Process>> procs;
+    };
+    struct alignas(64) IdShard {
+        mutable std::shared_mutex mtx;
+        PooledMap<int, std::shared_ptr<Process>> procs;
+    };
+
+    NameShard&       shard(const std::string& name);
+    const NameShard& shard(const std::string& name) const;
+    IdShard&         shard(int id);
+    const IdShard&   shard(int id) const;
+
+    std::vector<NameShard> by_name;
+    std::vector<IdShard>   by_id;
+
+    mutable std::shared_mutex running_mtx;
+    std::map<int, std::shared_ptr<Process>, std::less<int>,
+             PoolAllocator<std::pair<const int, std::shared_ptr<Process>>>> running;
+
+    mutable std::shared_mutex archive_mtx;
+    std::deque<FinishedProcess> finished;
+    std::unordered_map<std::string, std::size_t> finished_by_name;   // index into finished
+    mutable std::condition_variable_any finished_cv;   // waits on archive_mtx; archive() notifies
+};
@@ -0,0 +1,83 @@
+#include "program_cache.h"
+#include "instruction.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+
+std::shared_ptr<const Program> generate_program(std::mt19937& rng, int min_ins,
+                                                int max_ins, int delay)
+{
+    std::vector<std::unique_ptr<Instruction>> code;
+    std::uniform_int_distribution<int> icount(min_ins, max_ins);
+
+    // FOR bodies are SLEEPs, occasionally another FOR, up to kMaxLoopDepth deep
+    std::function<std::unique_ptr<Instruction>(std::size_t)> make_for =
+        [&](std::size_t depth) -> std::unique_ptr<Instruction> {
+        int repeats = 1 + rng() % 2;
+        int looplen = 1 + rng() % 2;
+        std::vector<std::unique_ptr<Instruction>> body;
+        for (int j = 0; j < looplen; ++j) {
+            if (depth + 1 < kMaxLoopDepth && rng() % 4 == 0)
+                body.push_back(make_for(depth + 1));
+            else
+                body.push_back(std::make_unique<SleepInst>(delay > 0 ? delay : 1));
+        }
+        return std::make_unique<ForInst>(repeats, std::move(body));
+    };
+
+    const int N = icount(rng);              
+    int var_count = 0;                      
+    std::vector<std::string> var_names;    
+
+    for (int i = 0; i < N; ++i) {
+        if (i % 2 == 0) {
+            code.push_back(std::make_unique<PrintInst>());
+            continue;
+        }
+
+        int t = rng() % 4;
+
+        if (t == 0) {                                 
+            std::string v = "v" + std::to_string(var_count++);
+            int val       = rng() % 100;
+            var_names.push_back(v);
+            code.push_back(std::make_unique<DeclInst>(v, val));
+
+        } else if (t == 1 || t == 2) {                  
+            std::string dest = "v" + std::to_string(rng() % (var_count + 1));
+            std::string op1  = var_names.empty()
+                             ? "0" : var_names[rng() % var_names.size()];
+            std::string op2  = std::to_string(rng() % 50);
+            bool is_add      = (t == 1);
+            code.push_back(
+                std::make_unique<MathInst>(dest, op1, op2, is_add));
+
+        } else {                                        
+            code.push_back(make_for(0));
+        }
+    }
+
+    bool has_print =
+        std::any_of(code.begin(), code.end(), [](const auto& up) {
+            return dynamic_cast<PrintInst*>(up.get()) != nullptr;
+        });
+    if (!has_print) {
+        code.insert(code.begin(), std::make_unique<PrintInst>());
+    }
+
+    return std::make_shared<const Program>(compile(code));
+}
+
+ProgramCache::ProgramCache(std::size_t pool_size, int min_ins, int max_ins, int delay,
+                           uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    pool.reserve(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i)
+        pool.push_back(generate_program(rng, min_ins, max_ins, delay));
+}
+
+std::shared_ptr<const Program> ProgramCache::pick()
+{
+    return pool[cursor.fetch_add(1, std::memory_order_relaxed) % pool.size()];
+}
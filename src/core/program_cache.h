@@ -0,0 +1,26 @@
+#pragma once
+#include "bytecode.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Builds a random program of min_ins..max_ins top-level instructions.
+std::shared_ptr<const Program> generate_program(std::mt19937& rng, int min_ins,
+                                                int max_ins, int delay);
+
+// Pool of immutable programs generated up front. Processes reference one by
+// shared pointer and keep only their registers, loop stack and pc private.
+// The same seed and parameters always yield the same pool, and pick() hands
+// programs out in a fixed rotation, so a seeded run is reproducible.
+class ProgramCache {
+public:
+    ProgramCache(std::size_t pool_size, int min_ins, int max_ins, int delay,
+                 uint32_t seed);
+    std::shared_ptr<const Program> pick();
+    std::size_t size() const { return pool.size(); }
+private:
+    std::vector<std::shared_ptr<const Program>> pool;
+    std::atomic<std::size_t> cursor{0};
+};
@@ -0,0 +1,32 @@
+#include "recent_events.h"
+#include <algorithm>
+
+RecentEvents::RecentEvents(uint32_t n)
+    : per_core(new PerCore[n]), cores(n)
+{}
+
+void RecentEvents::record(int core, const TraceRecord& rec)
+{
+    if (core < 0 || static_cast<uint32_t>(core) >= cores) return;
+    std::lock_guard<std::mutex> lk(per_core[core].mtx);
+    per_core[core].ring.push(rec);
+}
+
+std::vector<TraceRecord> RecentEvents::newest(std::size_t n) const
+{
+    std::vector<TraceRecord> all;
+    for (uint32_t c = 0; c < cores; ++c) {
+        auto view = [&] {
+            std::lock_guard<std::mutex> lk(per_core[c].mtx);
+            return per_core[c].ring.recent(n);
+        }();
+        all.insert(all.end(), view.begin(), view.end());
+    }
+    auto later = [](const TraceRecord& a, const TraceRecord& b) {
+        return a.cycle != b.cycle ? a.cycle > b.cycle : a.wall > b.wall;
+    };
+    const auto k = std::min(n, all.size());
+    std::partial_sort(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(k), all.end(), later);
+    all.resize(k);
+    return all;
+}
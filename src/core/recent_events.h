@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "log_ring.h"
+#include "trace.h"
+
+// Machine-wide tail of executed instructions for screen -ls / report-util.
+// Each core writes only its own ring, so its lock is contended only while a
+// reader merges; a read costs O(cores * n) regardless of process count.
+class RecentEvents {
+public:
+    static constexpr std::size_t kDepth = 8;     // per core
+
+    explicit RecentEvents(uint32_t cores);
+    void record(int core, const TraceRecord& rec);
+    // newest n records across all cores, newest first
+    std::vector<TraceRecord> newest(std::size_t n) const;
+
+private:
+    struct alignas(64) PerCore {
+        mutable std::mutex mtx;
+        LogRing<TraceRecord, kDepth> ring;
+    };
+    std::unique_ptr<PerCore[]> per_core;
+    uint32_t cores;
+};
@@ -0,0 +1,67 @@
+#include "sched_bench.h"
+#include "process_manager.h"
+#include "program_cache.h"
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+std::vector<SchedBenchResult> run_sched_bench(const SchedBenchConfig& cfg,
+                                              const std::vector<std::string>& schedulers)
+{
+    // one workload, shared by every run
+    std::mt19937 rng(cfg.seed);
+    std::vector<std::shared_ptr<const Program>> workload;
+    workload.reserve(cfg.jobs);
+    for (std::size_t i = 0; i < cfg.jobs; ++i)
+        workload.push_back(generate_program(rng, cfg.min_ins, cfg.max_ins, cfg.delay));
+
+    std::vector<SchedBenchResult> results;
+    for (const auto& alg : schedulers) {
+        ProcessManager pm(cfg.cores);
+        pm.initialize_scheduler(alg, cfg.quantum);
+        pm.set_tick_duration(0);
+        for (std::size_t i = 0; i < workload.size(); ++i)
+            pm.submit("bench" + std::to_string(i + 1), workload[i]);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        pm.start_scheduler();
+        pm.wait_for_finished(workload.size(), std::chrono::seconds(60));
+        const auto t1 = std::chrono::steady_clock::now();
+        pm.stop_scheduler();
+
+        SchedBenchResult r;
+        r.scheduler       = alg;
+        r.finished        = pm.turnaround_ticks().count();
+        r.mean_turnaround = pm.turnaround_ticks().mean();
+        r.p99_turnaround  = static_cast<double>(pm.turnaround_ticks().percentile(99));
+        r.mean_wait       = pm.wait_ticks().mean();
+        r.mean_response   = pm.response_ticks().mean();
+        r.wall_ms         = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        results.push_back(r);
+    }
+    return results;
+}
+
+void print_sched_bench(std::ostream& out, const SchedBenchConfig& cfg,
+                       const std::vector<SchedBenchResult>& results)
+{
+    out << "Scheduler benchmark: " << cfg.jobs << " jobs, seed " << cfg.seed
+        << ", " << cfg.cores << " cores, quantum " << cfg.quantum << " (times in ticks)\n"
+        << "  scheduler  finished  turnaround   p99 turn       wait   response  vs " 
+        << (results.empty() ? "" : results.front().scheduler) << '\n'
+        << std::fixed << std::setprecision(1);
+    const double base = results.empty() ? 0.0 : results.front().mean_turnaround;
+    for (const auto& r : results) {
+        out << "  " << std::left << std::setw(10) << r.scheduler << std::right
+            << std::setw(9)  << r.finished
+            << std::setw(12) << r.mean_turnaround
+            << std::setw(11) << r.p99_turnaround
+            << std::setw(11) << r.mean_wait
+            << std::setw(11) << r.mean_response;
+        if (base > 0)
+            out << std::setw(8) << (base - r.mean_turnaround) * 100.0 / base << " %";
+        if (r.finished < cfg.jobs) out << "  (timed out)";
+        out << '\n';
+    }
+    out << '\n';
+}
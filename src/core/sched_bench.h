@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Runs one seeded workload through several schedulers, unpaced and without
+// on-disk logs, so policies are compared on identical jobs. Every job
+// arrives at cycle 0.
+struct SchedBenchConfig {
+    uint32_t    cores   = 4;
+    uint64_t    quantum = 5;
+    std::size_t jobs    = 200;
+    int         min_ins = 10, max_ins = 100, delay = 0;
+    uint32_t    seed    = 42;
+};
+
+struct SchedBenchResult {
+    std::string scheduler;
+    std::size_t finished = 0;                 // < jobs if the run timed out
+    double mean_turnaround = 0, p99_turnaround = 0;
+    double mean_wait = 0, mean_response = 0;  // all in ticks
+    double wall_ms = 0;
+};
+
+std::vector<SchedBenchResult> run_sched_bench(const SchedBenchConfig& cfg,
+                                              const std::vector<std::string>& schedulers);
+// improvement is relative to the first result
+void print_sched_bench(std::ostream& out, const SchedBenchConfig& cfg,
+                       const std::vector<SchedBenchResult>& results);
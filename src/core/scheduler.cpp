@@ -1,20 +1,336 @@
 #include "scheduler.h"
+#include "cpu_utilization.h"
+#include <algorithm>
 
 // FCFS
-void FCFSScheduler::add_process(std::shared_ptr<Process> p) { std::lock_guard<std::mutex> lk(mtx); q.push_back(p); }
+void FCFSScheduler::add_process(std::shared_ptr<Process> p) {
+    { std::lock_guard<std::mutex> lk(mtx); q.push_back(std::move(p)); }
+    cv.notify_one();
+}
+void FCFSScheduler::add_batch(std::vector<std::shared_ptr<Process>>& batch) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (auto& p : batch) q.push_back(std::move(p));
+    }
+    batch.clear();
+    cv.notify_all();
+}
 std::shared_ptr<Process> FCFSScheduler::next_process() { std::lock_guard<std::mutex> lk(mtx); if (q.empty()) return nullptr; auto p = q.front(); q.pop_front(); return p; }
+std::shared_ptr<Process> FCFSScheduler::wait_process() {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv.wait(lk, [this] { return closed || !q.empty(); });
+    if (closed) return nullptr;
+    auto p = q.front(); q.pop_front();
+    return p;
+}
 bool FCFSScheduler::has_processes() const { std::lock_guard<std::mutex> lk(mtx); return !q.empty(); }
-void FCFSScheduler::reset() { std::lock_guard<std::mutex> lk(mtx); q.clear(); }
+std::size_t FCFSScheduler::queued() const { std::lock_guard<std::mutex> lk(mtx); return q.size(); }
+void FCFSScheduler::reset() { std::lock_guard<std::mutex> lk(mtx); q.clear(); closed = false; }
+void FCFSScheduler::shutdown() {
+    { std::lock_guard<std::mutex> lk(mtx); closed = true; }
+    cv.notify_all();
+}
 
 // Round Robin
+// The worker re-queues an unfinished process after its quantum, so the
+// queue never holds a process that is currently on a core.
 RRScheduler::RRScheduler(uint64_t q) : quantum(q) {}
-void RRScheduler::add_process(std::shared_ptr<Process> p) { std::lock_guard<std::mutex> lk(mtx); q.push_back(p); }
+void RRScheduler::add_process(std::shared_ptr<Process> p) {
+    { std::lock_guard<std::mutex> lk(mtx); q.push_back(std::move(p)); }
+    cv.notify_one();
+}
+void RRScheduler::add_batch(std::vector<std::shared_ptr<Process>>& batch) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (auto& p : batch) q.push_back(std::move(p));
+    }
+    batch.clear();
+    cv.notify_all();
+}
 std::shared_ptr<Process> RRScheduler::next_process() { 
     std::lock_guard<std::mutex> lk(mtx);
     if (q.empty()) return nullptr;
     auto p = q.front(); q.pop_front();
-    q.push_back(p);
+    return p;
+}
+std::shared_ptr<Process> RRScheduler::wait_process() {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv.wait(lk, [this] { return closed || !q.empty(); });
+    if (closed) return nullptr;
+    auto p = q.front(); q.pop_front();
     return p;
 }
 bool RRScheduler::has_processes() const { std::lock_guard<std::mutex> lk(mtx); return !q.empty(); }
-void RRScheduler::reset() { std::lock_guard<std::mutex> lk(mtx); q.clear(); }
\ No newline at end of file
+std::size_t RRScheduler::queued() const { std::lock_guard<std::mutex> lk(mtx); return q.size(); }
+void RRScheduler::reset() { std::lock_guard<std::mutex> lk(mtx); q.clear(); closed = false; }
+void RRScheduler::shutdown() {
+    { std::lock_guard<std::mutex> lk(mtx); closed = true; }
+    cv.notify_all();
+}
+
+// SJF / SRTF
+ShortestJobScheduler::ShortestJobScheduler(bool preempt) : preemptive(preempt) {}
+
+std::shared_ptr<Process> ShortestJobScheduler::pop_locked()
+{
+    if (heap.empty()) return nullptr;
+    auto p = heap.pop().p;
+    shortest.store(heap.empty() ? UINT64_MAX : heap.top().remaining, std::memory_order_relaxed);
+    return p;
+}
+
+void ShortestJobScheduler::add_process(std::shared_ptr<Process> p) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        const uint64_t rem = p->remaining_ticks();
+        heap.push({rem, next_seq++, std::move(p)});
+        shortest.store(heap.top().remaining, std::memory_order_relaxed);
+    }
+    cv.notify_one();
+}
+void ShortestJobScheduler::add_batch(std::vector<std::shared_ptr<Process>>& batch) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (auto& p : batch) {
+            const uint64_t rem = p->remaining_ticks();
+            heap.push({rem, next_seq++, std::move(p)});
+        }
+        if (!heap.empty()) shortest.store(heap.top().remaining, std::memory_order_relaxed);
+    }
+    batch.clear();
+    cv.notify_all();
+}
+std::shared_ptr<Process> ShortestJobScheduler::next_process() { std::lock_guard<std::mutex> lk(mtx); return pop_locked(); }
+std::shared_ptr<Process> ShortestJobScheduler::wait_process() {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv.wait(lk, [this] { return closed || !heap.empty(); });
+    if (closed) return nullptr;
+    return pop_locked();
+}
+bool ShortestJobScheduler::has_processes() const { std::lock_guard<std::mutex> lk(mtx); return !heap.empty(); }
+std::size_t ShortestJobScheduler::queued() const { std::lock_guard<std::mutex> lk(mtx); return heap.size(); }
+void ShortestJobScheduler::reset() {
+    std::lock_guard<std::mutex> lk(mtx);
+    heap.clear();
+    shortest.store(UINT64_MAX, std::memory_order_relaxed);
+    closed = false;
+}
+void ShortestJobScheduler::shutdown() {
+    { std::lock_guard<std::mutex> lk(mtx); closed = true; }
+    cv.notify_all();
+}
+bool ShortestJobScheduler::should_preempt(const Process& running) const {
+    return preemptive && shortest.load(std::memory_order_relaxed) < running.remaining_ticks();
+}
+
+// MLFQ
+// Levels and boost epochs live on the Process; the scheduler only touches
+// them while it holds the process (queued, or handed back by a worker).
+MLFQScheduler::MLFQScheduler(std::vector<uint64_t> q, uint64_t boost)
+    : levels(std::max<std::size_t>(1, q.size())), quanta(std::move(q)), boost_period(boost)
+{
+    if (quanta.empty()) quanta.push_back(1);
+}
+
+void MLFQScheduler::push_locked(std::shared_ptr<Process> p)
+{
+    if (p->sched_epoch != epoch) {             // missed a boost while running
+        p->sched_epoch = epoch;
+        p->sched_level = 0;
+    }
+    levels[p->sched_level].push_back(std::move(p));
+    ++count;
+}
+
+std::shared_ptr<Process> MLFQScheduler::pop_locked()
+{
+    const uint64_t now = cpu_cycles_counter.load(std::memory_order_relaxed);
+    if (boost_period && now - last_boost >= boost_period) {
+        last_boost = now;
+        ++epoch;
+        for (std::size_t l = 1; l < levels.size(); ++l) {
+            for (auto& p : levels[l]) levels[0].push_back(std::move(p));
+            levels[l].clear();
+        }
+        for (auto& p : levels[0]) { p->sched_level = 0; p->sched_epoch = epoch; }
+    }
+    for (auto& lvl : levels) {
+        if (lvl.empty()) continue;
+        auto p = std::move(lvl.front());
+        lvl.pop_front();
+        --count;
+        return p;
+    }
+    return nullptr;
+}
+
+// New processes start at level 0; one returning from a sleep keeps the level
+// it had, since it gave up the core before its quantum ran out.
+void MLFQScheduler::add_process(std::shared_ptr<Process> p) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        push_locked(std::move(p));
+    }
+    cv.notify_one();
+}
+void MLFQScheduler::add_batch(std::vector<std::shared_ptr<Process>>& batch) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (auto& p : batch) push_locked(std::move(p));
+    }
+    batch.clear();
+    cv.notify_all();
+}
+
+// Requeued processes used their full quantum, so they move down a level.
+void MLFQScheduler::requeue_from_core(int /*core*/, std::shared_ptr<Process> p) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (p->sched_epoch == epoch && p->sched_level + 1u < levels.size())
+            ++p->sched_level;
+        push_locked(std::move(p));
+    }
+    cv.notify_one();
+}
+
+std::shared_ptr<Process> MLFQScheduler::next_process() { std::lock_guard<std::mutex> lk(mtx); return pop_locked(); }
+std::shared_ptr<Process> MLFQScheduler::wait_process() {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv.wait(lk, [this] { return closed || count > 0; });
+    if (closed) return nullptr;
+    return pop_locked();
+}
+bool MLFQScheduler::has_processes() const { std::lock_guard<std::mutex> lk(mtx); return count > 0; }
+std::size_t MLFQScheduler::queued() const { std::lock_guard<std::mutex> lk(mtx); return count; }
+void MLFQScheduler::reset() {
+    std::lock_guard<std::mutex> lk(mtx);
+    for (auto& lvl : levels) lvl.clear();
+    count = 0; closed = false;
+}
+void MLFQScheduler::shutdown() {
+    { std::lock_guard<std::mutex> lk(mtx); closed = true; }
+    cv.notify_all();
+}
+uint64_t MLFQScheduler::quantum_for(const Process& p) const {
+    return quanta[std::min<std::size_t>(p.sched_level, quanta.size() - 1)];
+}
+
+// Work stealing
+// Queued processes are stored as raw pointers; Process::queue_pin keeps them
+// alive until a core takes them back out. The owner dequeues from the steal
+// end of its own deque so time-sliced processes still rotate FIFO.
+WorkStealingScheduler::WorkStealingScheduler(uint32_t cores, uint64_t q) : quantum(q)
+{
+    for (uint32_t i = 0; i < cores; ++i)
+        local.push_back(std::make_unique<ChaseLevDeque<Process*>>());
+}
+
+void WorkStealingScheduler::signal()
+{
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        { std::lock_guard<std::mutex> lk(wait_mtx); }
+        cv.notify_one();
+    }
+}
+
+void WorkStealingScheduler::add_process(std::shared_ptr<Process> p)
+{
+    { std::lock_guard<std::mutex> lk(inbox_mtx); inbox.push_back(std::move(p)); }
+    pending.fetch_add(1, std::memory_order_seq_cst);
+    signal();
+}
+
+void WorkStealingScheduler::add_batch(std::vector<std::shared_ptr<Process>>& batch)
+{
+    const auto n = static_cast<int64_t>(batch.size());
+    if (n == 0) return;
+    {
+        std::lock_guard<std::mutex> lk(inbox_mtx);
+        for (auto& p : batch) inbox.push_back(std::move(p));
+    }
+    batch.clear();
+    pending.fetch_add(n, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        { std::lock_guard<std::mutex> lk(wait_mtx); }
+        cv.notify_all();
+    }
+}
+
+void WorkStealingScheduler::requeue_from_core(int core, std::shared_ptr<Process> p)
+{
+    if (core < 0 || core >= static_cast<int>(local.size())) { add_process(std::move(p)); return; }
+    Process* raw = p.get();
+    raw->queue_pin = std::move(p);
+    local[core]->push(raw);
+    pending.fetch_add(1, std::memory_order_seq_cst);
+    signal();
+}
+
+std::shared_ptr<Process> WorkStealingScheduler::take(int core)
+{
+    const int n = static_cast<int>(local.size());
+    Process* raw = nullptr;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (core >= 0 && local[core]->steal(raw)) break;
+        {
+            std::lock_guard<std::mutex> lk(inbox_mtx);
+            if (!inbox.empty()) {
+                auto p = std::move(inbox.front());
+                inbox.pop_front();
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return p;
+            }
+        }
+        const int start = core < 0 ? 0 : core + 1;
+        for (int i = 0; i < n && !raw; ++i) {
+            int victim = (start + i) % n;
+            if (victim != core) local[victim]->steal(raw);
+        }
+        if (raw) break;
+    }
+    if (!raw) return nullptr;
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    return std::move(raw->queue_pin);
+}
+
+std::shared_ptr<Process> WorkStealingScheduler::next_for_core(int core) { return take(core); }
+std::shared_ptr<Process> WorkStealingScheduler::next_process() { return take(-1); }
+
+std::shared_ptr<Process> WorkStealingScheduler::wait_for_core(int core)
+{
+    for (;;) {
+        if (auto p = take(core)) return p;
+        std::unique_lock<std::mutex> lk(wait_mtx);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        cv.wait(lk, [this] {
+            return closed || pending.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (closed) return nullptr;
+    }
+}
+
+std::shared_ptr<Process> WorkStealingScheduler::wait_process() { return wait_for_core(-1); }
+
+bool WorkStealingScheduler::has_processes() const
+{
+    return pending.load(std::memory_order_acquire) > 0;
+}
+
+std::size_t WorkStealingScheduler::queued() const
+{
+    return static_cast<std::size_t>(std::max<int64_t>(0, pending.load(std::memory_order_relaxed)));
+}
+
+void WorkStealingScheduler::reset()
+{
+    while (take(-1)) {}
+    std::lock_guard<std::mutex> lk(wait_mtx);
+    closed = false;
+}
+
+void WorkStealingScheduler::shutdown()
+{
+    { std::lock_guard<std::mutex> lk(wait_mtx); closed = true; }
+    cv.notify_all();
+}
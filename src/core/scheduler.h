@@ -1,36 +1,187 @@
 #pragma once
+#include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <vector>
+#include "chase_lev_deque.h"
+#include "d_ary_heap.h"
+#include "object_pool.h"
 #include "process.h"
 
+// FIFO of ready processes; its chunks are recycled through PoolArena
+using ReadyQueue = std::deque<std::shared_ptr<Process>, PoolAllocator<std::shared_ptr<Process>>>;
+
 class SchedulerBase {
 public:
     virtual void add_process(std::shared_ptr<Process> p) = 0;
+    // queues every process in `batch` (emptying it); schedulers override
+    // this to take their lock and wake waiters once for the whole batch
+    virtual void add_batch(std::vector<std::shared_ptr<Process>>& batch) {
+        for (auto& p : batch) add_process(std::move(p));
+        batch.clear();
+    }
     virtual std::shared_ptr<Process> next_process() = 0;
+    // blocks until a process is ready; nullptr once shutdown() was called
+    virtual std::shared_ptr<Process> wait_process() = 0;
     virtual bool has_processes() const = 0;
+    // number of processes waiting for a core (approximate under contention)
+    virtual std::size_t queued() const = 0;
     virtual void reset() = 0;
+    // wakes every waiter and makes further waits return immediately
+    virtual void shutdown() = 0;
+
+    // Worker-side entry points. Schedulers with per-core run queues override
+    // these; the defaults forward to the shared queue.
+    virtual std::shared_ptr<Process> next_for_core(int /*core*/) { return next_process(); }
+    virtual std::shared_ptr<Process> wait_for_core(int /*core*/) { return wait_process(); }
+    virtual void requeue_from_core(int /*core*/, std::shared_ptr<Process> p) { add_process(std::move(p)); }
+    // ticks a dispatched process may run before it is requeued
+    virtual uint64_t quantum_for(const Process& /*p*/) const { return 1; }
+    // polled by the worker after each tick; true cuts the quantum short
+    virtual bool should_preempt(const Process& /*running*/) const { return false; }
+
     virtual ~SchedulerBase() = default;
 };
 
 class FCFSScheduler : public SchedulerBase {
     mutable std::mutex mtx;
-    std::deque<std::shared_ptr<Process>> q;
+    std::condition_variable cv;
+    ReadyQueue q;
+    bool closed = false;
 public:
     void add_process(std::shared_ptr<Process> p) override;
+    void add_batch(std::vector<std::shared_ptr<Process>>& batch) override;
     std::shared_ptr<Process> next_process() override;
+    std::shared_ptr<Process> wait_process() override;
     bool has_processes() const override;
+    std::size_t queued() const override;
     void reset() override;
+    void shutdown() override;
+    uint64_t quantum_for(const Process&) const override { return UINT64_MAX; }   // run to completion
 };
 
 class RRScheduler : public SchedulerBase {
     mutable std::mutex mtx;
-    std::deque<std::shared_ptr<Process>> q;
+    std::condition_variable cv;
+    ReadyQueue q;
     uint64_t quantum;
+    bool closed = false;
 public:
     explicit RRScheduler(uint64_t q);
     void add_process(std::shared_ptr<Process> p) override;
+    void add_batch(std::vector<std::shared_ptr<Process>>& batch) override;
+    std::shared_ptr<Process> next_process() override;
+    std::shared_ptr<Process> wait_process() override;
+    bool has_processes() const override;
+    std::size_t queued() const override;
+    void reset() override;
+    void shutdown() override;
+    uint64_t quantum_for(const Process&) const override { return quantum; }
+};
+
+// Shortest job first, ordered by Process::remaining_ticks(), which is exact.
+// Non-preemptive (SJF) runs each job to completion. Preemptive (SRTF) gives
+// up the core as soon as a queued job has less work left than the running one.
+class ShortestJobScheduler : public SchedulerBase {
+    struct Entry {
+        uint64_t remaining;
+        uint64_t seq;                          // FIFO among equal lengths
+        std::shared_ptr<Process> p;
+    };
+    struct Shorter {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.remaining != b.remaining ? a.remaining < b.remaining : a.seq < b.seq;
+        }
+    };
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    DaryHeap<Entry, Shorter> heap;
+    uint64_t next_seq = 0;
+    // remaining_ticks of the heap top, read lock-free by should_preempt
+    alignas(64) std::atomic<uint64_t> shortest{UINT64_MAX};
+    const bool preemptive;
+    bool closed = false;
+
+    std::shared_ptr<Process> pop_locked();
+public:
+    explicit ShortestJobScheduler(bool preemptive);
+    void add_process(std::shared_ptr<Process> p) override;
+    void add_batch(std::vector<std::shared_ptr<Process>>& batch) override;
+    std::shared_ptr<Process> next_process() override;
+    std::shared_ptr<Process> wait_process() override;
+    bool has_processes() const override;
+    std::size_t queued() const override;
+    void reset() override;
+    void shutdown() override;
+
+    uint64_t quantum_for(const Process&) const override { return UINT64_MAX; }
+    bool should_preempt(const Process& running) const override;
+};
+
+// Multi-level feedback queue. New processes enter level 0 and drop one level
+// each time they use up a quantum; lower levels get longer quanta. Every
+// `boost_period` cycles everything returns to level 0 so long jobs cannot
+// starve behind a stream of short ones.
+class MLFQScheduler : public SchedulerBase {
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<ReadyQueue> levels;
+    std::vector<uint64_t> quanta;              // per level
+    uint64_t boost_period;                     // cycles, 0 = never
+    uint64_t last_boost = 0;
+    uint32_t epoch = 0;                        // bumped by each boost
+    std::size_t count = 0;
+    bool closed = false;
+
+    void push_locked(std::shared_ptr<Process> p);
+    std::shared_ptr<Process> pop_locked();
+public:
+    MLFQScheduler(std::vector<uint64_t> quanta, uint64_t boost_period);
+    void add_process(std::shared_ptr<Process> p) override;
+    void add_batch(std::vector<std::shared_ptr<Process>>& batch) override;
     std::shared_ptr<Process> next_process() override;
+    std::shared_ptr<Process> wait_process() override;
     bool has_processes() const override;
+    std::size_t queued() const override;
     void reset() override;
+    void shutdown() override;
+
+    void requeue_from_core(int core, std::shared_ptr<Process> p) override;
+    uint64_t quantum_for(const Process& p) const override;
+};
+
+
+// One Chase-Lev deque per core plus a locked inbox for processes submitted
+// from outside the worker threads. A core drains its own deque, then the
+// inbox, then steals from the other cores.
+class WorkStealingScheduler : public SchedulerBase {
+    std::vector<std::unique_ptr<ChaseLevDeque<Process*>>> local;
+    std::mutex inbox_mtx;
+    ReadyQueue inbox;
+    alignas(64) std::atomic<int64_t> pending{0};     // queued anywhere
+    alignas(64) std::atomic<int>     sleepers{0};
+    std::mutex              wait_mtx;
+    std::condition_variable cv;
+    bool closed = false;
+    uint64_t quantum;
+
+    std::shared_ptr<Process> take(int core);
+    void signal();
+public:
+    WorkStealingScheduler(uint32_t cores, uint64_t quantum);
+    void add_process(std::shared_ptr<Process> p) override;
+    void add_batch(std::vector<std::shared_ptr<Process>>& batch) override;
+    std::shared_ptr<Process> next_process() override;
+    std::shared_ptr<Process> wait_process() override;
+    bool has_processes() const override;
+    std::size_t queued() const override;
+    void reset() override;
+    void shutdown() override;
+
+    std::shared_ptr<Process> next_for_core(int core) override;
+    std::shared_ptr<Process> wait_for_core(int core) override;
+    void requeue_from_core(int core, std::shared_ptr<Process> p) override;
+    uint64_t quantum_for(const Process&) const override { return quantum; }
 };
\ No newline at end of file
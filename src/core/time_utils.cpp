@@ -1,24 +1,42 @@
 #include "time_utils.h"
 #include <chrono>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 
 namespace util {
 
-std::string now_time()
+const char* format_time(std::time_t t)
 {
-    using std::chrono::system_clock;
-    auto t = system_clock::to_time_t(system_clock::now());
-    std::tm tm{};
+    thread_local std::time_t cached_sec = -1;
+    thread_local char        buf[20] = {};
+
+    if (t != cached_sec) {
+        std::tm tm{};
 #ifdef _WIN32
-    localtime_s(&tm, &t);
+        localtime_s(&tm, &t);
 #else
-    localtime_r(&t, &tm);
+        localtime_r(&t, &tm);
 #endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+        std::strftime(buf, sizeof buf, "%Y-%m-%d %H:%M:%S", &tm);
+        cached_sec = t;
+    }
+    return buf;
+}
+
+const char* now_time_cstr()
+{
+    using std::chrono::system_clock;
+    return format_time(system_clock::to_time_t(system_clock::now()));
+}
+
+std::string now_time()
+{
+    return now_time_cstr();
+}
+
+int64_t steady_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 }
@@ -1,3 +1,14 @@
 #pragma once
+#include <cstdint>
+#include <ctime>
 #include <string>
-namespace util { std::string now_time(); }
\ No newline at end of file
+namespace util {
+std::string now_time();
+// "YYYY-MM-DD HH:MM:SS" in a per-thread buffer, re-formatted only when the
+// second changes. Valid until the calling thread's next call.
+const char* now_time_cstr();
+// same buffer and cache, for an arbitrary second
+const char* format_time(std::time_t t);
+// monotonic nanoseconds, for measuring intervals
+int64_t steady_ns();
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Hierarchical timing wheel keyed on an absolute tick. Four levels of 64
+// slots cover 2^24 ticks ahead of now(); later timers wait in an overflow
+// list until the top level rolls over. Scheduling is O(1); advancing skips
+// runs of empty slots, so jumping the clock far ahead stays cheap. Not
+// synchronized; the owner guards it.
+template <typename T>
+class TimerWheel {
+public:
+    static constexpr unsigned kBits   = 6;
+    static constexpr unsigned kSlots  = 1u << kBits;
+    static constexpr unsigned kLevels = 4;
+
+    uint64_t    now()   const { return now_; }
+    std::size_t size()  const { return count_; }
+    bool        empty() const { return count_ == 0; }
+
+    // fires on the first advance() to `due` or later; a due time that has
+    // already passed fires on the next tick
+    void schedule(uint64_t due, T item)
+    {
+        place({std::max(due, now_ + 1), std::move(item)});
+        ++count_;
+    }
+
+    // moves the clock to `t`, appending every item due by then to `fired`
+    void advance(uint64_t t, std::vector<T>& fired)
+    {
+        while (now_ < t) {
+            if (count_ == 0) { now_ = t; break; }
+
+            // all levels below `l` are empty: skip to the tick before the
+            // next level-`l` boundary, where a cascade may refill them
+            unsigned l = 0;
+            while (l < kLevels && level_count[l] == 0) ++l;
+            if (l > 0) {
+                const uint64_t last = now_ | ((uint64_t(1) << (kBits * l)) - 1);
+                if (last > now_) { now_ = std::min(t, last); if (now_ == t) break; }
+            }
+
+            ++now_;
+            if ((now_ & ((uint64_t(1) << (kBits * kLevels)) - 1)) == 0) {
+                auto spill = std::move(overflow);
+                overflow.clear();
+                for (auto& tm : spill) place(std::move(tm));
+            }
+            for (unsigned lvl = kLevels - 1; lvl >= 1; --lvl) {
+                if ((now_ & ((uint64_t(1) << (kBits * lvl)) - 1)) != 0) continue;
+                auto& slot = wheel[lvl][(now_ >> (kBits * lvl)) & (kSlots - 1)];
+                auto moved = std::move(slot);
+                slot.clear();
+                level_count[lvl] -= moved.size();
+                for (auto& tm : moved) place(std::move(tm));
+            }
+            auto& due = wheel[0][now_ & (kSlots - 1)];
+            level_count[0] -= due.size();
+            count_ -= due.size();
+            for (auto& tm : due) fired.push_back(std::move(tm.item));
+            due.clear();
+        }
+    }
+
+    // earliest tick at which advance() could fire something; exact for the
+    // lowest occupied level, a lower bound above it. UINT64_MAX when empty.
+    uint64_t next_due() const
+    {
+        for (unsigned lvl = 0; lvl < kLevels; ++lvl) {
+            if (level_count[lvl] == 0) continue;
+            const unsigned shift = kBits * lvl;
+            const uint64_t cur   = (now_ >> shift) & (kSlots - 1);
+            for (uint64_t s = cur + 1; s < kSlots; ++s)
+                if (!wheel[lvl][s].empty()) {
+                    const uint64_t base = (now_ >> (shift + kBits)) << (shift + kBits);
+                    return base | (s << shift);
+                }
+        }
+        uint64_t best = UINT64_MAX;
+        for (const auto& tm : overflow) best = std::min(best, tm.due);
+        return best;
+    }
+
+private:
+    struct Timer { uint64_t due; T item; };
+
+    // a timer lives on the lowest level whose slot range still contains it
+    void place(Timer tm)
+    {
+        for (unsigned lvl = 0; lvl < kLevels; ++lvl) {
+            const unsigned above = kBits * (lvl + 1);
+            if ((tm.due >> above) == (now_ >> above)) {
+                wheel[lvl][(tm.due >> (kBits * lvl)) & (kSlots - 1)].push_back(std::move(tm));
+                ++level_count[lvl];
+                return;
+            }
+        }
+        overflow.push_back(std::move(tm));
+    }
+
+    std::array<std::array<std::vector<Timer>, kSlots>, kLevels> wheel{};
+    std::array<std::size_t, kLevels> level_count{};
+    std::vector<Timer> overflow;
+    uint64_t    now_   = 0;
+    std::size_t count_ = 0;
+};
@@ -0,0 +1,28 @@
+#include "trace.h"
+#include "time_utils.h"
+#include <cinttypes>
+#include <cstdio>
+
+std::size_t render_trace(const TraceRecord& r, char* buf, std::size_t len, bool verbose)
+{
+    const char* ts = util::format_time(static_cast<std::time_t>(r.wall));
+    int n;
+    if (r.kind == TraceRecord::FINISHED)
+        n = std::snprintf(buf, len, "FINISHED at %s", ts);
+    else if (!verbose)
+        n = std::snprintf(buf, len, "(%s) Core:%d PC=%" PRIu32 " %s",
+                          ts, r.core, r.pc, op_tag(r.op));
+    else
+        n = std::snprintf(buf, len, "(%s) Core:%d PC=%" PRIu32 " %s cycle=%" PRIu64
+                          " a=%" PRIu32 " b=%" PRIu32 " r=%" PRIu32,
+                          ts, r.core, r.pc, op_tag(r.op), r.cycle,
+                          r.arg0, r.arg1, r.result);
+    if (n < 0) n = 0;
+    return static_cast<std::size_t>(n) < len ? static_cast<std::size_t>(n) : len - 1;
+}
+
+std::string render_trace(const TraceRecord& r, bool verbose)
+{
+    char buf[160];
+    return std::string(buf, render_trace(r, buf, sizeof buf, verbose));
+}
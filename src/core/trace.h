@@ -0,0 +1,35 @@
+#pragma once
+#include "bytecode.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Compact binary record of one executed tick. Logs store these as-is;
+// render_trace() turns one into the classic text line on demand:
+//   (2025-06-28 22:56:41) Core:3 PC=5 FOR
+//   FINISHED at 2025-06-28 22:56:41
+struct TraceRecord {
+    enum Kind : uint8_t { EXEC = 0, FINISHED = 1 };
+    int64_t  wall   = 0;        // time_t seconds
+    uint64_t cycle  = 0;        // cpu_cycles_counter when executed
+    uint32_t pc     = 0;
+    int16_t  core   = -1;
+    Kind     kind   = EXEC;
+    Op       op     = Op::PRINT;
+    uint32_t arg0   = 0;        // 1st operand value, SLEEP ticks, FOR repeats
+    uint32_t arg1   = 0;        // 2nd operand value
+    uint32_t result = 0;        // value written by DECL/ADD/SUB
+    uint32_t pad    = 0;
+};
+static_assert(sizeof(TraceRecord) == 40, "on-disk layout");
+
+// logs/<name>.bin = TraceFileHeader followed by TraceRecords (host endian)
+struct TraceFileHeader {
+    char     magic[4] = {'C', 'S', 'L', 'G'};
+    uint32_t version  = 1;
+};
+
+// writes the text form into buf (NUL-terminated); returns its length
+std::size_t render_trace(const TraceRecord& r, char* buf, std::size_t len,
+                         bool verbose = false);
+std::string render_trace(const TraceRecord& r, bool verbose = false);
@@ -0,0 +1,123 @@
+#include "utilization_sampler.h"
+#include <algorithm>
+#include <iomanip>
+
+UtilizationSampler::UtilizationSampler(const CPUUtilization& u,
+                                       std::function<std::size_t()> queue_depth,
+                                       std::chrono::milliseconds p, std::size_t cap)
+    : util(u), depth_fn(std::move(queue_depth)), period(p),
+      capacity(std::max<std::size_t>(1, cap)),
+      cores(static_cast<std::size_t>(u.get_total_cores())),
+      util_pct(capacity), depth(capacity), per_core(capacity * cores)
+{
+    const auto s = util.sample();
+    last_busy_ns = s.core_busy_ns;
+    last_ns      = s.taken_ns;
+    worker = std::thread([this] { run(); });
+}
+
+UtilizationSampler::~UtilizationSampler()
+{
+    { std::lock_guard<std::mutex> lk(mtx); stopping = true; }
+    cv.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void UtilizationSampler::run()
+{
+    std::unique_lock<std::mutex> lk(mtx);
+    while (!cv.wait_for(lk, period, [this] { return stopping; })) {
+        lk.unlock();
+        take_sample();
+        lk.lock();
+    }
+}
+
+// Busy fraction over the last period, from the change in cumulative busy ns.
+void UtilizationSampler::take_sample()
+{
+    const auto s = util.sample();
+    const std::size_t q = depth_fn ? depth_fn() : 0;
+    const double elapsed = static_cast<double>(std::max<int64_t>(1, s.taken_ns - last_ns));
+
+    std::lock_guard<std::mutex> lk(mtx);
+    double sum = 0;
+    for (std::size_t c = 0; c < cores; ++c) {
+        const double b = static_cast<double>(s.core_busy_ns[c] - std::min(s.core_busy_ns[c], last_busy_ns[c]));
+        const double pct = std::min(100.0, b * 100.0 / elapsed);
+        per_core[next * cores + c] = static_cast<float>(pct);
+        sum += pct;
+    }
+    util_pct[next] = static_cast<float>(cores ? sum / cores : 0.0);
+    depth[next]    = static_cast<uint32_t>(std::min<std::size_t>(q, UINT32_MAX));
+    next = (next + 1) % capacity;
+    if (count < capacity) ++count;
+
+    last_busy_ns = s.core_busy_ns;
+    last_ns      = s.taken_ns;
+}
+
+static double percentile(std::vector<double>& v, double p)
+{
+    if (v.empty()) return 0;
+    auto k = static_cast<std::size_t>(p / 100.0 * static_cast<double>(v.size() - 1) + 0.5);
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+UtilizationSampler::Window UtilizationSampler::window(std::chrono::milliseconds span) const
+{
+    Window w;
+    std::vector<double> u, d;
+    w.core_mean.assign(cores, 0.0);
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        const auto want = static_cast<std::size_t>(std::max<int64_t>(1, span / period));
+        w.samples = std::min(want, count);
+        u.reserve(w.samples);
+        d.reserve(w.samples);
+        for (std::size_t i = 0; i < w.samples; ++i) {
+            const std::size_t row = (next + capacity - 1 - i) % capacity;
+            u.push_back(util_pct[row]);
+            d.push_back(depth[row]);
+            for (std::size_t c = 0; c < cores; ++c)
+                w.core_mean[c] += per_core[row * cores + c];
+        }
+    }
+    if (w.samples == 0) return w;
+
+    const double n = static_cast<double>(w.samples);
+    for (auto& c : w.core_mean) c /= n;
+    for (double x : u) w.mean_util  += x / n;
+    for (double x : d) w.mean_depth += x / n;
+    w.max_util  = *std::max_element(u.begin(), u.end());
+    w.max_depth = *std::max_element(d.begin(), d.end());
+    w.p50_util  = percentile(u, 50);
+    w.p95_util  = percentile(u, 95);
+    w.p99_util  = percentile(u, 99);
+    w.p95_depth = percentile(d, 95);
+    return w;
+}
+
+void UtilizationSampler::print_report(std::ostream& out) const
+{
+    using std::chrono::milliseconds;
+    out << "Utilization trend (sampled every " << period.count() << " ms):\n"
+        << "  window  samples   mean    p50    p95    p99    max | queue mean  p95  max\n"
+        << std::fixed << std::setprecision(1);
+    for (auto [label, span] : { std::pair{"1s ", milliseconds(1000)},
+                                std::pair{"10s", milliseconds(10000)},
+                                std::pair{"60s", milliseconds(60000)} }) {
+        const auto w = window(span);
+        out << "  " << label << "   " << std::setw(8) << w.samples
+            << std::setw(7) << w.mean_util << std::setw(7) << w.p50_util
+            << std::setw(7) << w.p95_util  << std::setw(7) << w.p99_util
+            << std::setw(7) << w.max_util  << " |" << std::setw(11) << w.mean_depth
+            << std::setw(5) << w.p95_depth << std::setw(5) << w.max_depth << '\n';
+    }
+    const auto w = window(milliseconds(10000));
+    out << "  per-core busy % (10s):";
+    for (std::size_t c = 0; c < w.core_mean.size(); ++c)
+        out << (c % 8 == 0 ? "\n   " : "") << ' ' << std::setw(5) << w.core_mean[c];
+    out << "\n\n";
+}
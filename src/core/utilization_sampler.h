@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "cpu_utilization.h"
+
+// Background thread that samples CPUUtilization and the ready-queue depth
+// at a fixed period into a fixed-size ring, and summarizes trailing windows
+// (e.g. the last 1 s / 10 s / 60 s) as means and percentiles.
+class UtilizationSampler {
+public:
+    struct Window {
+        std::size_t samples = 0;
+        double mean_util = 0, p50_util = 0, p95_util = 0, p99_util = 0, max_util = 0;
+        double mean_depth = 0, p95_depth = 0, max_depth = 0;
+        std::vector<double> core_mean;           // per-core busy %, same window
+    };
+
+    UtilizationSampler(const CPUUtilization& util,
+                       std::function<std::size_t()> queue_depth,
+                       std::chrono::milliseconds period = std::chrono::milliseconds(100),
+                       std::size_t capacity = 600);
+    ~UtilizationSampler();
+
+    Window window(std::chrono::milliseconds span) const;
+    void   print_report(std::ostream& out) const;
+
+private:
+    void run();
+    void take_sample();
+
+    const CPUUtilization&        util;
+    std::function<std::size_t()> depth_fn;
+    const std::chrono::milliseconds period;
+    const std::size_t            capacity;
+    const std::size_t            cores;
+
+    mutable std::mutex   mtx;
+    // ring of `capacity` rows; row i holds util[i], depth[i], per_core[i*cores..]
+    std::vector<float>   util_pct;
+    std::vector<uint32_t> depth;
+    std::vector<float>   per_core;
+    std::size_t          next = 0, count = 0;
+
+    // previous cumulative reading, for deltas
+    std::vector<uint64_t> last_busy_ns;
+    int64_t               last_ns = 0;
+
+    std::condition_variable cv;
+    bool                    stopping = false;
+    std::thread             worker;
+};
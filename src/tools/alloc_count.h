@@ -0,0 +1,34 @@
+#pragma once
+// Counts heap allocations by replacing the global operator new/delete.
+// Replacement operators cannot be inline, so include this from exactly one
+// translation unit of a benchmark binary; nothing in csopesy_core uses it.
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+inline std::atomic<uint64_t> g_heap_allocs{0};
+inline thread_local uint64_t  t_heap_allocs = 0;
+
+// every thread
+inline uint64_t heap_allocs() { return g_heap_allocs.load(std::memory_order_relaxed); }
+// the calling thread only, unaffected by workers allocating meanwhile
+inline uint64_t thread_heap_allocs() { return t_heap_allocs; }
+
+// kept out of line: once inlined, GCC pairs malloc() and free() with
+// the new-expressions and warns -Wmismatched-new-delete
+#if defined(__GNUC__)
+#define CSOPESY_NOINLINE __attribute__((noinline))
+#else
+#define CSOPESY_NOINLINE
+#endif
+
+CSOPESY_NOINLINE void* operator new(std::size_t n)
+{
+    g_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    ++t_heap_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+CSOPESY_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+CSOPESY_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
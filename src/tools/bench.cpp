@@ -0,0 +1,162 @@
+// csopesy-bench: runs a seeded, deterministic process mix to completion
+// without the console and prints one JSON object, so scheduler and
+// interpreter throughput can be compared between builds.
+//
+//   csopesy-bench [--config config.txt] [--seed N] [--jobs N] [--waves N]
+//                 [--scheduler NAME] [--tick-duration MS] [--timeout S]
+//
+// The config supplies cores, quantum and the program shape; the flags
+// override it. tick-duration defaults to 0 (unpaced). Processes p1..pN are
+// admitted up front from the seeded program pool, so the same seed and
+// config always produce the same workload. With --waves W the jobs are
+// admitted in W equal waves, each once the previous one has finished, so
+// later waves run on recycled pool slots; admit_allocs_per_job counts heap
+// allocations while admitting those later waves (or the only wave).
+// Exits 1 on a bad config or if the run does not finish within the timeout.
+#include "core/config_manager.h"
+#include "core/object_pool.h"
+#include "core/process_manager.h"
+#include "alloc_count.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static uint64_t peak_rss_kb()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof pmc))
+        return pmc.PeakWorkingSetSize / 1024;
+    return 0;
+#else
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return static_cast<uint64_t>(ru.ru_maxrss) / 1024;     // bytes on macOS
+#else
+    return static_cast<uint64_t>(ru.ru_maxrss);            // kB on Linux
+#endif
+#endif
+}
+
+static void usage()
+{
+    std::cout << "usage: csopesy-bench [--config FILE] [--seed N] [--jobs N] [--waves N]\n"
+                 "                     [--scheduler NAME] [--tick-duration MS] [--timeout S]\n";
+}
+
+static int run(int argc, char** argv)
+{
+    std::string config_path = "config.txt";
+    std::string seed = "42", scheduler, tick = "0";
+    uint64_t jobs = 1000, waves = 1, timeout_s = 600;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { usage(); std::exit(1); }
+            return argv[++i];
+        };
+        if (a == "--config")             config_path = next();
+        else if (a == "--seed")          seed = std::to_string(std::stoul(next()));
+        else if (a == "--jobs")          jobs = std::stoull(next());
+        else if (a == "--waves")         waves = std::max<uint64_t>(1, std::stoull(next()));
+        else if (a == "--scheduler")     scheduler = next();
+        else if (a == "--tick-duration") tick = std::to_string(std::stoull(next()));
+        else if (a == "--timeout")       timeout_s = std::stoull(next());
+        else if (a == "-h" || a == "--help") { usage(); return 0; }
+        else { usage(); return 1; }
+    }
+
+    ConfigManager cfg;
+    if (!cfg.load(config_path)) return 1;
+    cfg.set("seed", seed);
+    cfg.set("tick-duration", tick);
+    if (!scheduler.empty()) {
+        if (scheduler != "fcfs" && scheduler != "rr" && scheduler != "ws" &&
+            scheduler != "mlfq" && scheduler != "sjf" && scheduler != "srtf") {
+            std::cerr << "unknown scheduler: " << scheduler << '\n';
+            return 1;
+        }
+        cfg.set("scheduler", scheduler);
+    }
+
+    const auto cores = static_cast<uint32_t>(cfg.get_long("num-cpu"));
+    ProcessManager pm(cores);
+    pm.set_config_manager(&cfg);
+    pm.initialize_scheduler(cfg.get("scheduler"), cfg.get_long("quantum-cycles"));
+
+    const uint64_t cycles0 = cpu_cycles_counter.load();
+    const uint64_t allocs0 = heap_allocs();
+    uint64_t admit_allocs = 0, admitted = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto deadline = t0 + std::chrono::seconds(timeout_s);
+    pm.start_scheduler();
+    bool done = true;
+    for (uint64_t w = 0; w < waves && done; ++w) {
+        const uint64_t last = jobs * (w + 1) / waves;
+        const uint64_t first = jobs * w / waves + 1;
+        const uint64_t before = thread_heap_allocs();
+        for (uint64_t i = first; i <= last; ++i)
+            pm.add_process("p" + std::to_string(i));
+        if (w > 0 || waves == 1) {
+            admit_allocs += thread_heap_allocs() - before;
+            admitted     += last - first + 1;
+        }
+        done = pm.wait_for_finished(last, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                              deadline - std::chrono::steady_clock::now()));
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const uint64_t allocs = heap_allocs() - allocs0;
+    const uint64_t ticks = cpu_cycles_counter.load() - cycles0;
+    const auto util = pm.utilization();
+    pm.stop_scheduler();
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    const auto& turn_ticks = pm.turnaround_ticks();
+    const auto& turn_ns    = pm.turnaround_ns();
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "{\n"
+        << "  \"scheduler\": \"" << cfg.get("scheduler") << "\",\n"
+        << "  \"cores\": " << cores << ",\n"
+        << "  \"seed\": " << seed << ",\n"
+        << "  \"jobs\": " << jobs << ",\n"
+        << "  \"waves\": " << waves << ",\n"
+        << "  \"finished\": " << turn_ticks.count() << ",\n"
+        << "  \"wall_s\": " << secs << ",\n"
+        << "  \"instructions\": " << util.busy_ticks << ",\n"
+        << "  \"instructions_per_s\": " << (secs > 0 ? util.busy_ticks / secs : 0.0) << ",\n"
+        << "  \"ticks\": " << ticks << ",\n"
+        << "  \"ticks_per_s\": " << (secs > 0 ? ticks / secs : 0.0) << ",\n"
+        << "  \"turnaround_ticks\": { \"mean\": " << turn_ticks.mean()
+        << ", \"p99\": " << turn_ticks.percentile(99) << " },\n"
+        << "  \"turnaround_ms\": { \"mean\": " << turn_ns.mean() / 1e6
+        << ", \"p99\": " << turn_ns.percentile(99) / 1e6 << " },\n"
+        << "  \"admit_allocs_per_job\": " << (admitted ? double(admit_allocs) / admitted : 0.0) << ",\n"
+        << "  \"heap_allocs_per_job\": " << (jobs ? double(allocs) / jobs : 0.0) << ",\n"
+        << "  \"pool_reserved_kb\": " << PoolArena::instance().stats().reserved_bytes / 1024 << ",\n"
+        << "  \"peak_rss_kb\": " << peak_rss_kb() << "\n"
+        << "}\n";
+    return done ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "csopesy-bench: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,77 @@
+// csopesy-logdump: renders binary per-process traces (logs/<name>.bin) back
+// into the text log format, one logs/<name>.txt per trace.
+//
+//   csopesy-logdump [-v] [--stdout] [path ...]     (default path: logs)
+//
+// A path may be a .bin file or a directory of them. -v appends the cycle and
+// operand values to every line; --stdout prints instead of writing .txt files.
+#include "core/trace.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static bool dump(const fs::path& bin, bool verbose, bool to_stdout)
+{
+    std::ifstream in(bin, std::ios::binary);
+    TraceFileHeader hdr, want;
+    if (!in.read(reinterpret_cast<char*>(&hdr), sizeof hdr) ||
+        std::memcmp(hdr.magic, want.magic, sizeof hdr.magic) != 0 ||
+        hdr.version != want.version) {
+        std::cerr << bin.string() << ": not a trace file\n";
+        return false;
+    }
+
+    std::ofstream file;
+    if (!to_stdout) {
+        fs::path txt = bin;
+        txt.replace_extension(".txt");
+        file.open(txt, std::ios::trunc);
+        if (!file) { std::cerr << txt.string() << ": cannot write\n"; return false; }
+    }
+    std::ostream& out = to_stdout ? std::cout : file;
+
+    TraceRecord rec;
+    char line[160];
+    while (in.read(reinterpret_cast<char*>(&rec), sizeof rec)) {
+        out.write(line, static_cast<std::streamsize>(render_trace(rec, line, sizeof line, verbose)));
+        out.put('\n');
+    }
+    if (in.gcount() != 0)
+        std::cerr << bin.string() << ": truncated record ignored\n";
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool verbose = false, to_stdout = false;
+    std::vector<fs::path> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-v")            verbose = true;
+        else if (a == "--stdout") to_stdout = true;
+        else if (a == "-h" || a == "--help") {
+            std::cout << "usage: csopesy-logdump [-v] [--stdout] [path ...]\n";
+            return 0;
+        }
+        else paths.emplace_back(a);
+    }
+    if (paths.empty()) paths.emplace_back("logs");
+
+    int failures = 0;
+    for (const auto& p : paths) {
+        std::error_code ec;
+        if (fs::is_directory(p, ec)) {
+            for (const auto& e : fs::directory_iterator(p, ec))
+                if (e.path().extension() == ".bin" && !dump(e.path(), verbose, to_stdout))
+                    ++failures;
+        } else if (!dump(p, verbose, to_stdout)) {
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
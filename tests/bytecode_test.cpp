@@ -0,0 +1,94 @@
+#include "core/bytecode.h"
+#include "core/instruction.h"
+#include "core/process.h"
+#include "core/program_cache.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// instructions run_one_tick actually executes until the process finishes
+uint64_t executed(std::shared_ptr<const Program> prog)
+{
+    Process p("t", 1, std::move(prog));
+    uint64_t n = 0;
+    while (!p.is_finished()) {
+        if (p.run_one_tick()) ++n;
+        p.take_sleep();
+    }
+    return n;
+}
+
+std::unique_ptr<Instruction> nest(int depth)
+{
+    std::vector<std::unique_ptr<Instruction>> body;
+    if (depth > 1) body.push_back(nest(depth - 1));
+    else body.push_back(std::make_unique<MathInst>("x", "x", "1", true));
+    return std::make_unique<ForInst>(2, std::move(body));
+}
+
+}  // namespace
+
+// FOR jumps past its END, END jumps back to the first body op
+TEST(Compile, ForLowersToForBodyEnd)
+{
+    std::vector<std::unique_ptr<Instruction>> body;
+    body.push_back(std::make_unique<MathInst>("x", "x", "1", true));
+    std::vector<std::unique_ptr<Instruction>> code;
+    code.push_back(std::make_unique<DeclInst>("x", 0));
+    code.push_back(std::make_unique<ForInst>(3, std::move(body)));
+    const Program prog = compile(code);
+
+    ASSERT_EQ(prog.code.size(), 4u);
+    EXPECT_EQ(prog.code[1].op, Op::FOR);
+    EXPECT_EQ(prog.code[1].a, 3);
+    EXPECT_EQ(prog.code[1].imm, 4u);
+    EXPECT_EQ(prog.code[2].op, Op::ADD);
+    EXPECT_EQ(prog.code[3].op, Op::END);
+    EXPECT_EQ(prog.code[3].imm, 2u);
+}
+
+TEST(Compile, RejectsForNestedPastLoopStack)
+{
+    std::vector<std::unique_ptr<Instruction>> ok;
+    ok.push_back(nest(static_cast<int>(kMaxLoopDepth)));
+    EXPECT_NO_THROW(compile(ok));
+
+    std::vector<std::unique_ptr<Instruction>> deep;
+    deep.push_back(nest(static_cast<int>(kMaxLoopDepth) + 1));
+    EXPECT_THROW(compile(deep), std::runtime_error);
+}
+
+TEST(CountTicks, NestedLoops)
+{
+    std::vector<std::unique_ptr<Instruction>> inner;
+    inner.push_back(std::make_unique<MathInst>("x", "x", "1", true));
+    std::vector<std::unique_ptr<Instruction>> outer;
+    outer.push_back(std::make_unique<ForInst>(3, std::move(inner)));
+    outer.push_back(std::make_unique<SleepInst>(2));
+    std::vector<std::unique_ptr<Instruction>> code;
+    code.push_back(std::make_unique<DeclInst>("x", 0));
+    code.push_back(std::make_unique<ForInst>(4, std::move(outer)));
+    code.push_back(std::make_unique<ForInst>(0, std::vector<std::unique_ptr<Instruction>>{}));
+    auto prog = std::make_shared<const Program>(compile(code));
+
+    EXPECT_EQ(prog->ticks, count_ticks(*prog));
+    EXPECT_EQ(executed(prog), prog->ticks);
+
+    Process p("t", 1, prog);
+    while (!p.is_finished()) { p.run_one_tick(); p.take_sleep(); }
+    EXPECT_EQ(p.get_var("x"), 12);
+}
+
+// Program::ticks, which SJF/SRTF schedule on, is exact for generated programs
+TEST(CountTicks, MatchesInterpreterOnGeneratedPrograms)
+{
+    std::mt19937 rng(11);
+    for (int i = 0; i < 500; ++i) {
+        auto prog = generate_program(rng, 1, 60, 1);
+        ASSERT_EQ(executed(prog), prog->ticks) << "program " << i;
+    }
+}
@@ -0,0 +1,53 @@
+#include "core/chase_lev_deque.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(ChaseLevDeque, OwnerPopsLifoThiefStealsFifo)
+{
+    ChaseLevDeque<intptr_t> d(2);
+    for (intptr_t i = 1; i <= 10; ++i) d.push(i);     // grows past the initial ring
+    intptr_t v = 0;
+    ASSERT_TRUE(d.steal(v));
+    EXPECT_EQ(v, 1);
+    ASSERT_TRUE(d.pop(v));
+    EXPECT_EQ(v, 10);
+    int left = 0;
+    while (d.pop(v)) ++left;
+    EXPECT_EQ(left, 8);
+    EXPECT_TRUE(d.empty());
+    EXPECT_FALSE(d.steal(v));
+}
+
+// the owner pushes and pops while thieves steal; every item is taken
+// exactly once
+TEST(ChaseLevDeque, ConcurrentStealTakesEachItemOnce)
+{
+    constexpr intptr_t kItems = 200000;
+    constexpr int kThieves = 3;
+    ChaseLevDeque<intptr_t> d(4);
+    std::vector<std::atomic<int>> taken(kItems + 1);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t)
+        thieves.emplace_back([&] {
+            intptr_t v;
+            while (!done.load(std::memory_order_acquire) || !d.empty())
+                if (d.steal(v)) taken[v].fetch_add(1, std::memory_order_relaxed);
+        });
+
+    intptr_t v;
+    for (intptr_t i = 1; i <= kItems; ++i) {
+        d.push(i);
+        if (i % 3 == 0 && d.pop(v)) taken[v].fetch_add(1, std::memory_order_relaxed);
+    }
+    while (d.pop(v)) taken[v].fetch_add(1, std::memory_order_relaxed);
+    done.store(true, std::memory_order_release);
+    for (auto& t : thieves) t.join();
+
+    for (intptr_t i = 1; i <= kItems; ++i)
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+}
@@ -0,0 +1,37 @@
+#include "core/config_manager.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// loads the required keys plus `extra` from a scratch file
+bool load_with(const std::string& extra)
+{
+    const auto path = std::filesystem::temp_directory_path() / "csopesy-config-test.txt";
+    {
+        std::ofstream f(path);
+        f << "num-cpu 2\nscheduler \"mlfq\"\nquantum-cycles 2\nbatch-process-freq 1\n"
+             "min-ins 1\nmax-ins 10\ndelays-per-exec 0\n" << extra;
+    }
+    ConfigManager cfg;
+    const bool ok = cfg.load(path.string());
+    std::filesystem::remove(path);
+    return ok;
+}
+
+}  // namespace
+
+TEST(ConfigManager, MlfqQuantaAlone)
+{
+    EXPECT_TRUE(load_with("mlfq-quanta \"2,4,8\"\n"));
+    EXPECT_TRUE(load_with("mlfq-levels 4\n"));
+}
+
+TEST(ConfigManager, MlfqLevelsMustMatchQuanta)
+{
+    EXPECT_TRUE(load_with("mlfq-levels 3\nmlfq-quanta \"2,4,8\"\n"));
+    EXPECT_FALSE(load_with("mlfq-levels 4\nmlfq-quanta \"2,4,8\"\n"));
+    EXPECT_FALSE(load_with("mlfq-quanta \"2,4,8\"\nmlfq-levels 2\n"));
+}
@@ -0,0 +1,40 @@
+#include "core/d_ary_heap.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+TEST(DaryHeap, PopsInOrder)
+{
+    std::mt19937 rng(5);
+    DaryHeap<int> h;
+    std::vector<int> vals;
+    for (int i = 0; i < 1000; ++i) { vals.push_back(rng() % 100); h.push(vals.back()); }
+    std::sort(vals.begin(), vals.end());
+    for (int v : vals) {
+        ASSERT_EQ(h.top(), v);
+        ASSERT_EQ(h.pop(), v);
+    }
+    EXPECT_TRUE(h.empty());
+}
+
+TEST(DaryHeap, InterleavedMatchesReference)
+{
+    std::mt19937 rng(9);
+    DaryHeap<int, std::greater<int>, 3> h;     // max-heap, odd arity
+    std::vector<int> ref;
+    for (int i = 0; i < 20000; ++i) {
+        if (ref.empty() || rng() % 3) {
+            const int v = static_cast<int>(rng() % 1000);
+            h.push(v);
+            ref.push_back(v);
+            std::push_heap(ref.begin(), ref.end());
+        } else {
+            std::pop_heap(ref.begin(), ref.end());
+            ASSERT_EQ(h.pop(), ref.back());
+            ref.pop_back();
+        }
+        ASSERT_EQ(h.size(), ref.size());
+    }
+}
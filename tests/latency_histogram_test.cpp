@@ -0,0 +1,67 @@
+#include "core/latency_histogram.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(LatencyHistogram, Empty)
+{
+    LatencyHistogram h;
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.percentile(50), 0u);
+    EXPECT_EQ(h.mean(), 0.0);
+}
+
+TEST(LatencyHistogram, SmallValuesAreExact)
+{
+    LatencyHistogram h;
+    for (uint64_t v = 0; v < LatencyHistogram::kSub; ++v) h.record(v);
+    EXPECT_EQ(h.count(), LatencyHistogram::kSub);
+    EXPECT_EQ(h.max(), LatencyHistogram::kSub - 1);
+    EXPECT_EQ(h.percentile(100), LatencyHistogram::kSub - 1);
+    EXPECT_EQ(h.percentile(50), LatencyHistogram::kSub / 2 - 1);
+    EXPECT_DOUBLE_EQ(h.mean(), (LatencyHistogram::kSub - 1) / 2.0);
+}
+
+// percentiles stay within one sub-bucket (~1/kSub) of the exact answer
+TEST(LatencyHistogram, PercentileWithinRelativeError)
+{
+    std::mt19937_64 rng(3);
+    LatencyHistogram h;
+    std::vector<uint64_t> vals;
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t v = rng() >> (rng() % 60);
+        vals.push_back(v);
+        h.record(v);
+    }
+    std::sort(vals.begin(), vals.end());
+    for (double p : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+        const uint64_t exact = vals[static_cast<std::size_t>(p / 100.0 * vals.size() + 0.999999) - 1];
+        const uint64_t got = h.percentile(p);
+        EXPECT_GE(got, exact) << "p" << p;
+        EXPECT_LE(static_cast<double>(got - exact), exact / double(LatencyHistogram::kSub) + 1) << "p" << p;
+    }
+    EXPECT_EQ(h.percentile(100), vals.back());
+}
+
+TEST(LatencyHistogram, ExtremeValues)
+{
+    LatencyHistogram h;
+    h.record(UINT64_MAX);
+    h.record(uint64_t(1) << 63);
+    EXPECT_EQ(h.max(), UINT64_MAX);
+    EXPECT_EQ(h.percentile(100), UINT64_MAX);
+    EXPECT_GE(h.percentile(50), uint64_t(1) << 63);
+}
+
+TEST(LatencyHistogram, ConcurrentRecordLosesNothing)
+{
+    LatencyHistogram h;
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t)
+        ts.emplace_back([&h, t] { for (uint64_t i = 0; i < 50000; ++i) h.record(i + t); });
+    for (auto& t : ts) t.join();
+    EXPECT_EQ(h.count(), 200000u);
+    EXPECT_EQ(h.max(), 49999u + 3);
+}
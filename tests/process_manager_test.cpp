@@ -0,0 +1,85 @@
+#include "core/bytecode.h"
+#include "core/cpu_utilization.h"
+#include "core/instruction.h"
+#include "core/process_manager.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A SLEEP as the last instruction finishes the process on that tick. It
+// must be archived right away, not parked on the timer wheel and
+// dispatched a second time once the sleep expires.
+TEST(ProcessManager, TrailingSleepFinishesWithoutParking)
+{
+    std::vector<std::unique_ptr<Instruction>> code;
+    code.push_back(std::make_unique<DeclInst>("x", 1));
+    code.push_back(std::make_unique<SleepInst>(50));
+    auto prog = std::make_shared<const Program>(compile(code));
+
+    ProcessManager pm(1);
+    pm.set_tick_duration(0);
+    pm.initialize_scheduler("rr", 5);
+    pm.start_scheduler();
+    const uint64_t start = cpu_cycles_counter.load();
+    auto p = pm.submit("trailing-sleep", prog);
+    ASSERT_TRUE(pm.wait_for_finished(1, std::chrono::seconds(10)));
+    const uint64_t elapsed = cpu_cycles_counter.load() - start;
+    pm.stop_scheduler();
+
+    EXPECT_TRUE(p->is_finished());
+    EXPECT_FALSE(p->is_sleeping());
+    EXPECT_EQ(p->sched_times().dispatches, 1u);
+    EXPECT_FALSE(pm.get_process("trailing-sleep"));
+    EXPECT_LT(elapsed, 50u);
+}
+
+// process-smi on a process that finished while attached reads the archive
+TEST(ProcessManager, ProcessSmiReportsArchivedProcess)
+{
+    std::vector<std::unique_ptr<Instruction>> code;
+    code.push_back(std::make_unique<DeclInst>("x", 1));
+    code.push_back(std::make_unique<PrintInst>());
+    auto prog = std::make_shared<const Program>(compile(code));
+
+    ProcessManager pm(1);
+    pm.set_tick_duration(0);
+    pm.initialize_scheduler("rr", 5);
+    pm.start_scheduler();
+    auto p = pm.submit("smi", prog);
+    ASSERT_TRUE(pm.wait_for_finished(1, std::chrono::seconds(10)));
+    pm.stop_scheduler();
+    ASSERT_FALSE(pm.get_process("smi"));
+
+    std::ostringstream out;
+    ASSERT_TRUE(pm.print_process_smi("smi", out));
+    EXPECT_NE(out.str().find("ID: " + std::to_string(p->get_id()) + '\n'), std::string::npos);
+    EXPECT_NE(out.str().find("Current instruction line: 2/2\n"), std::string::npos);
+    EXPECT_NE(out.str().find("FINISHED!"), std::string::npos);
+
+    std::ostringstream none;
+    EXPECT_FALSE(pm.print_process_smi("no-such-process", none));
+    EXPECT_TRUE(none.str().empty());
+}
+
+// benchmark refuses to share cpu_cycles_counter with live processes
+TEST(ProcessManager, IdleOnlyWithoutLiveProcesses)
+{
+    std::vector<std::unique_ptr<Instruction>> code;
+    code.push_back(std::make_unique<SleepInst>(20));
+    code.push_back(std::make_unique<DeclInst>("x", 1));
+    auto prog = std::make_shared<const Program>(compile(code));
+
+    ProcessManager pm(1);
+    pm.set_tick_duration(0);
+    pm.initialize_scheduler("rr", 5);
+    EXPECT_TRUE(pm.is_idle());
+    pm.submit("live", prog);
+    EXPECT_FALSE(pm.is_idle());
+    pm.start_scheduler();
+    ASSERT_TRUE(pm.wait_for_finished(1, std::chrono::seconds(10)));
+    pm.stop_scheduler();
+    EXPECT_TRUE(pm.is_idle());
+}
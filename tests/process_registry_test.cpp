@@ -0,0 +1,110 @@
+#include "core/bytecode.h"
+#include "core/process_registry.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::shared_ptr<Process> make(const std::string& name, int id)
+{
+    static const auto prog = std::make_shared<const Program>();
+    return std::make_shared<Process>(name, id, prog);
+}
+
+}  // namespace
+
+TEST(ProcessRegistry, InsertBatchIndexesByNameAndId)
+{
+    ProcessRegistry reg(4);
+    std::vector<std::shared_ptr<Process>> batch;
+    for (int i = 1; i <= 100; ++i) batch.push_back(make("p" + std::to_string(i), i));
+    reg.insert_batch(batch);
+
+    EXPECT_EQ(batch.size(), 100u);
+    EXPECT_EQ(reg.live_count(), 100u);
+    for (int i = 1; i <= 100; ++i) {
+        auto by_name = reg.find("p" + std::to_string(i));
+        ASSERT_TRUE(by_name);
+        EXPECT_EQ(by_name, reg.find(i));
+    }
+    const auto head = reg.live_head(10);
+    ASSERT_EQ(head.size(), 10u);
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(head[i]->get_id(), i + 1);
+}
+
+// a name already registered (screen -s racing the batch thread) keeps its
+// process; the duplicate is dropped from the batch and from the id index
+TEST(ProcessRegistry, InsertBatchDropsTakenNames)
+{
+    ProcessRegistry reg(4);
+    auto existing = make("p2", 2);
+    ASSERT_EQ(reg.insert(existing), existing);
+
+    std::vector<std::shared_ptr<Process>> batch = {make("p1", 10), make("p2", 11), make("p3", 12)};
+    reg.insert_batch(batch);
+
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0]->get_name(), "p1");
+    EXPECT_EQ(batch[1]->get_name(), "p3");
+    EXPECT_EQ(reg.find("p2"), existing);
+    EXPECT_FALSE(reg.find(11));
+    EXPECT_EQ(reg.live_count(), 3u);
+}
+
+TEST(ProcessRegistry, ArchiveMovesToFinished)
+{
+    ProcessRegistry reg;
+    auto p = make("p1", 1);
+    reg.insert(p);
+    reg.archive(p);
+    EXPECT_FALSE(reg.find("p1"));
+    EXPECT_FALSE(reg.find(1));
+    EXPECT_EQ(reg.live_count(), 0u);
+    ASSERT_EQ(reg.finished_count(), 1u);
+    auto f = reg.find_finished("p1");
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f->id, 1);
+}
+
+TEST(ProcessRegistry, WaitFinishedWakesOnArchive)
+{
+    using namespace std::chrono;
+    ProcessRegistry reg;
+    std::vector<std::shared_ptr<Process>> procs;
+    for (int i = 1; i <= 3; ++i) procs.push_back(reg.insert(make("p" + std::to_string(i), i)));
+
+    EXPECT_FALSE(reg.wait_finished(1, steady_clock::now() + milliseconds(10)));
+    std::thread retire([&] {
+        for (auto& p : procs) {
+            std::this_thread::sleep_for(milliseconds(5));
+            reg.archive(p);
+        }
+    });
+    EXPECT_TRUE(reg.wait_finished(3, steady_clock::now() + seconds(10)));
+    EXPECT_EQ(reg.finished_count(), 3u);
+    retire.join();
+}
+
+TEST(ProcessRegistry, ConcurrentBatchesAndLookups)
+{
+    ProcessRegistry reg(8);
+    constexpr int kThreads = 4, kBatches = 50, kPerBatch = 64;
+    std::vector<std::thread> ts;
+    for (int t = 0; t < kThreads; ++t)
+        ts.emplace_back([&reg, t] {
+            for (int b = 0; b < kBatches; ++b) {
+                std::vector<std::shared_ptr<Process>> batch;
+                const int base = (t * kBatches + b) * kPerBatch;
+                for (int i = 0; i < kPerBatch; ++i)
+                    batch.push_back(make("p" + std::to_string(base + i), base + i));
+                reg.insert_batch(batch);
+                for (auto& p : batch) EXPECT_EQ(reg.find(p->get_name()), p);
+            }
+        });
+    for (auto& t : ts) t.join();
+    EXPECT_EQ(reg.live_count(), std::size_t(kThreads * kBatches * kPerBatch));
+}
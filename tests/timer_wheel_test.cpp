@@ -0,0 +1,86 @@
+#include "core/timer_wheel.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+TEST(TimerWheel, FiresAtDueTick)
+{
+    TimerWheel<int> w;
+    w.schedule(5, 1);
+    std::vector<int> fired;
+    w.advance(4, fired);
+    EXPECT_TRUE(fired.empty());
+    EXPECT_EQ(w.next_due(), 5u);
+    w.advance(5, fired);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0], 1);
+    EXPECT_TRUE(w.empty());
+    EXPECT_EQ(w.next_due(), UINT64_MAX);
+}
+
+TEST(TimerWheel, PastDueFiresOnNextTick)
+{
+    TimerWheel<int> w;
+    std::vector<int> fired;
+    w.advance(100, fired);
+    w.schedule(10, 7);
+    w.advance(101, fired);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0], 7);
+}
+
+// timers on every level and in the overflow list cascade down and fire on
+// exactly their due tick, even when advance() jumps far ahead
+TEST(TimerWheel, CascadeAndOverflow)
+{
+    TimerWheel<uint64_t> w;
+    const std::vector<uint64_t> dues = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144,
+                                        (1u << 24) - 1, 1u << 24, (1u << 24) + 1,
+                                        (uint64_t(1) << 30) + 12345};
+    for (uint64_t d : dues) w.schedule(d, d);
+    std::vector<uint64_t> fired;
+    for (uint64_t d : dues) {
+        EXPECT_LE(w.next_due(), d);
+        w.advance(d - 1, fired);
+        EXPECT_TRUE(fired.empty()) << "fired early before " << d;
+        w.advance(d, fired);
+        ASSERT_EQ(fired.size(), 1u) << "due " << d;
+        EXPECT_EQ(fired[0], d);
+        fired.clear();
+    }
+    EXPECT_TRUE(w.empty());
+}
+
+TEST(TimerWheel, MatchesReferenceUnderRandomSchedule)
+{
+    std::mt19937_64 rng(1);
+    TimerWheel<int> w;
+    std::multimap<uint64_t, int> ref;
+    uint64_t now = 0;
+    int next = 0;
+    for (int round = 0; round < 2000; ++round) {
+        for (int i = rng() % 4; i > 0; --i) {
+            const uint64_t span = uint64_t(1) << (rng() % 28);
+            const uint64_t due = now + 1 + rng() % span;
+            w.schedule(due, next);
+            ref.emplace(due, next++);
+        }
+        // next_due() never overshoots the true earliest timer
+        if (!ref.empty()) {
+            EXPECT_LE(w.next_due(), ref.begin()->first);
+        }
+        now += 1 + rng() % (uint64_t(1) << (rng() % 20));
+        std::vector<int> fired;
+        w.advance(now, fired);
+        std::multiset<int> want;
+        for (auto it = ref.begin(); it != ref.end() && it->first <= now;) {
+            want.insert(it->second);
+            it = ref.erase(it);
+        }
+        EXPECT_EQ(std::multiset<int>(fired.begin(), fired.end()), want) << "round " << round;
+        EXPECT_EQ(w.size(), ref.size());
+    }
+}